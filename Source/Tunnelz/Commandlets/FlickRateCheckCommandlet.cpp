@@ -0,0 +1,42 @@
+#include "FlickRateCheckCommandlet.h"
+
+#include "../Gesture/FlickPipeline.h"
+#include "../Gesture/FlickRateCheck.h"
+#include "../Player/AMainPawn.h"
+
+UFlickRateCheckCommandlet::UFlickRateCheckCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UFlickRateCheckCommandlet::Main(const FString& Params)
+{
+    FlickRateCheck::FSettings Settings;
+    FString RatesArg, PawnArg;
+    if (FParse::Value(*Params, TEXT("Rates="), RatesArg, false))
+    {
+        TArray<FString> Rates;
+        RatesArg.ParseIntoArray(Rates, TEXT(","));
+        Settings.RatesHz.Reset();
+        for (const FString& Rate : Rates)
+            Settings.RatesHz.Add(FCString::Atof(*Rate));
+    }
+    FParse::Value(*Params, TEXT("Jitter="), Settings.JitterFraction);
+    FParse::Value(*Params, TEXT("Pawn="), PawnArg);
+
+    const AMainPawn* Pawn = GetDefault<AMainPawn>();
+    if (!PawnArg.IsEmpty())
+    {
+        if (UClass* PawnClass = LoadClass<AMainPawn>(nullptr, *PawnArg))
+            Pawn = PawnClass->GetDefaultObject<AMainPawn>();
+        else
+            UE_LOG(LogTemp, Warning, TEXT("Cannot load pawn class %s, using defaults"), *PawnArg);
+    }
+    FFlickPipeline Config;
+    Pawn->ConfigureFlickPipeline(Config);
+
+    return FlickRateCheck::Run(Config, Settings, *GLog) ? 0 : 1;
+}
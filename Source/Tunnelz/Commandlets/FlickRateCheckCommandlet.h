@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "FlickRateCheckCommandlet.generated.h"
+
+// Headless sample-rate independence check for the flick pipeline; exits non-zero on failure.
+// UnrealEditor-Cmd Tunnelz.uproject -run=FlickRateCheck [-Rates=30,60,90,120] [-Jitter=0.0] [-Pawn=<class path>]
+UCLASS()
+class TUNNELZ_API UFlickRateCheckCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UFlickRateCheckCommandlet();
+    virtual int32 Main(const FString& Params) override;
+};
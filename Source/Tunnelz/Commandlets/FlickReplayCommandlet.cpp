@@ -0,0 +1,64 @@
+#include "FlickReplayCommandlet.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+#include "../Gesture/FlickPipeline.h"
+#include "../Gesture/ImuTrace.h"
+#include "../Player/AMainPawn.h"
+
+UFlickReplayCommandlet::UFlickReplayCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UFlickReplayCommandlet::Main(const FString& Params)
+{
+    FString TraceArg, EventsArg, PawnArg;
+    if (!FParse::Value(*Params, TEXT("Trace="), TraceArg))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Usage: -run=FlickReplay -Trace=<file.tzimu|dir> [-Events=<file.csv|dir>] [-Pawn=<class path>]"));
+        return 1;
+    }
+    FParse::Value(*Params, TEXT("Events="), EventsArg);
+    FParse::Value(*Params, TEXT("Pawn="), PawnArg);
+
+    // Tuning comes from the pawn Blueprint when given, C++ defaults otherwise
+    const AMainPawn* Pawn = GetDefault<AMainPawn>();
+    if (!PawnArg.IsEmpty())
+    {
+        if (UClass* PawnClass = LoadClass<AMainPawn>(nullptr, *PawnArg))
+            Pawn = PawnClass->GetDefaultObject<AMainPawn>();
+        else
+            UE_LOG(LogTemp, Warning, TEXT("Cannot load pawn class %s, using defaults"), *PawnArg);
+    }
+    FFlickPipeline Config;
+    Pawn->ConfigureFlickPipeline(Config);
+
+    TArray<FString> Traces;
+    if (FPaths::DirectoryExists(TraceArg))
+    {
+        IFileManager::Get().FindFiles(Traces, *(TraceArg / TEXT("*.tzimu")), true, false);
+        for (FString& T : Traces)
+            T = TraceArg / T;
+    }
+    else
+    {
+        Traces.Add(TraceArg);
+    }
+
+    const bool bEventsDir = Traces.Num() > 1 || FPaths::DirectoryExists(EventsArg);
+    int32 NumFailed = 0;
+    for (const FString& Trace : Traces)
+    {
+        FString EventsPath = EventsArg;
+        if (bEventsDir && !EventsArg.IsEmpty())
+            EventsPath = EventsArg / FPaths::GetBaseFilename(Trace) + TEXT(".flicks.csv");
+
+        if (!ImuTrace::ReplayFile(Trace, Config, EventsPath, *GLog))
+            ++NumFailed;
+    }
+    return NumFailed > 0 ? 1 : 0;
+}
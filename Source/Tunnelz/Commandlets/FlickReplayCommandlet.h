@@ -0,0 +1,18 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "FlickReplayCommandlet.generated.h"
+
+// Headless replay of recorded IMU traces through the flick pipeline.
+// UnrealEditor-Cmd Tunnelz.uproject -run=FlickReplay -Trace=<file.tzimu|dir> [-Events=<file.csv|dir>]
+//     [-Pawn=/Game/Core/Blueprints/GameFramework/BP_PlayerPawn.BP_PlayerPawn_C]
+UCLASS()
+class TUNNELZ_API UFlickReplayCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UFlickReplayCommandlet();
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,254 @@
+#include "FlickTuneCommandlet.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include "../Gesture/FlickTuning.h"
+#include "../Player/AMainPawn.h"
+
+namespace
+{
+    struct FCandidate
+    {
+        FFlickTuningParams Params;
+        FFlickTuningScore Score;
+    };
+
+    void EvaluateAll(TArray<FCandidate>& Candidates, const FFlickPipeline& Base, TConstArrayView<const FLabeledTrace*> Traces)
+    {
+        ParallelFor(Candidates.Num(), [&](int32 i)
+        {
+            Candidates[i].Score = FlickTuning::Evaluate(Candidates[i].Params, Base, Traces);
+        });
+    }
+
+    // Merges New into the non-dominated set Front
+    void UpdateFront(TArray<FCandidate>& Front, const TArray<FCandidate>& New)
+    {
+        for (const FCandidate& C : New)
+        {
+            if (C.Score.TruePositives == 0)
+                continue;
+
+            bool bDominated = false;
+            for (const FCandidate& F : Front)
+            {
+                if (F.Score.Dominates(C.Score))
+                {
+                    bDominated = true;
+                    break;
+                }
+            }
+            if (bDominated)
+                continue;
+
+            Front.RemoveAllSwap([&C](const FCandidate& F) { return C.Score.Dominates(F.Score); });
+            Front.Add(C);
+        }
+    }
+
+    float Gaussian(FRandomStream& Rng)
+    {
+        // Box-Muller
+        const float U1 = FMath::Max(Rng.GetFraction(), 1e-7f);
+        const float U2 = Rng.GetFraction();
+        return FMath::Sqrt(-2.f * FMath::Loge(U1)) * FMath::Cos(2.f * PI * U2);
+    }
+}
+
+UFlickTuneCommandlet::UFlickTuneCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UFlickTuneCommandlet::Main(const FString& Params)
+{
+    FString TracesDir, PawnArg, OutPath;
+    FString GridKnobsArg = TEXT("StartRateRad,EndRateRad,MaxDuration,Deadzone");
+    int32 GridLevels = 3, Rounds = 8, PerRound = 2000, Seed = 1;
+    if (!FParse::Value(*Params, TEXT("Traces="), TracesDir))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Usage: -run=FlickTune -Traces=<dir> [-Pawn=] [-Grid=3] [-GridKnobs=a,b] [-Rounds=8] [-PerRound=2000] [-Seed=1] [-Out=]"));
+        return 1;
+    }
+    FParse::Value(*Params, TEXT("Pawn="), PawnArg);
+    FParse::Value(*Params, TEXT("GridKnobs="), GridKnobsArg);
+    FParse::Value(*Params, TEXT("Grid="), GridLevels);
+    FParse::Value(*Params, TEXT("Rounds="), Rounds);
+    FParse::Value(*Params, TEXT("PerRound="), PerRound);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    if (!FParse::Value(*Params, TEXT("Out="), OutPath))
+        OutPath = FPaths::ProjectSavedDir() / TEXT("FlickTuning") / FString::Printf(TEXT("Pareto_%s.csv"), *FDateTime::Now().ToString());
+
+    // -------- Labeled traces, mapped once and shared read-only by all workers --------
+    TArray<FString> Files;
+    IFileManager::Get().FindFiles(Files, *(TracesDir / TEXT("*.tzimu")), true, false);
+
+    TArray<TUniquePtr<FLabeledTrace>> Traces;
+    for (const FString& File : Files)
+    {
+        TUniquePtr<FLabeledTrace> T = MakeUnique<FLabeledTrace>();
+        T->Path = TracesDir / File;
+        const FString LabelPath = TracesDir / FPaths::GetBaseFilename(File) + TEXT(".labels.csv");
+        if (!FlickTuning::LoadLabels(LabelPath, T->Labels))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Skipping %s: no %s"), *File, *FPaths::GetCleanFilename(LabelPath));
+            continue;
+        }
+        if (T->Trace.Open(T->Path))
+            Traces.Add(MoveTemp(T));
+    }
+    if (Traces.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("No labeled traces in %s"), *TracesDir);
+        return 1;
+    }
+
+    TArray<const FLabeledTrace*> TraceViews;
+    int32 NumLabels = 0;
+    for (const TUniquePtr<FLabeledTrace>& T : Traces)
+    {
+        TraceViews.Add(T.Get());
+        NumLabels += T->Labels.Num();
+    }
+
+    // -------- Baseline from the pawn --------
+    const AMainPawn* Pawn = GetDefault<AMainPawn>();
+    if (!PawnArg.IsEmpty())
+    {
+        if (UClass* PawnClass = LoadClass<AMainPawn>(nullptr, *PawnArg))
+            Pawn = PawnClass->GetDefaultObject<AMainPawn>();
+    }
+    FFlickPipeline Base;
+    Pawn->ConfigureFlickPipeline(Base);
+
+    TArray<FCandidate> Baseline = { { FFlickTuningParams::FromPipeline(Base), {} } };
+    EvaluateAll(Baseline, Base, TraceViews);
+    UE_LOG(LogTemp, Display, TEXT("%d traces, %d labels. Baseline: P=%.3f R=%.3f F1=%.3f latency=%.1fms"),
+        Traces.Num(), NumLabels, Baseline[0].Score.Precision(), Baseline[0].Score.Recall(),
+        Baseline[0].Score.F1(), Baseline[0].Score.MeanLatencyMs());
+
+    const double StartTime = FPlatformTime::Seconds();
+    int64 NumEvaluated = 0;
+    TArray<FCandidate> Front;
+    UpdateFront(Front, Baseline);
+
+    // -------- Coarse grid over the chosen knobs, others at baseline --------
+    TArray<int32> GridKnobs;
+    TArray<FString> KnobNames;
+    GridKnobsArg.ParseIntoArray(KnobNames, TEXT(","));
+    for (const FString& Name : KnobNames)
+    {
+        const int32 Knob = FFlickTuningParams::FindKnob(Name.TrimStartAndEnd());
+        if (Knob != INDEX_NONE)
+            GridKnobs.AddUnique(Knob);
+        else
+            UE_LOG(LogTemp, Warning, TEXT("Unknown knob %s"), *Name);
+    }
+
+    GridLevels = FMath::Max(GridLevels, 2);
+    int64 GridSize = 1;
+    for (int32 k = 0; k < GridKnobs.Num(); ++k)
+        GridSize *= GridLevels;
+    if (GridSize > 1000000)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Grid of %lld points is too large, use fewer knobs or levels"), GridSize);
+        return 1;
+    }
+
+    {
+        TArray<FCandidate> Grid;
+        Grid.Reserve(int32(GridSize));
+        for (int64 Index = 0; Index < GridSize; ++Index)
+        {
+            FCandidate C = Baseline[0];
+            int64 Rest = Index;
+            for (int32 Knob : GridKnobs)
+            {
+                const FFlickTuningParams::FKnobInfo& Info = FFlickTuningParams::GetKnobInfo(Knob);
+                const float T = float(Rest % GridLevels) / float(GridLevels - 1);
+                C.Params.Values[Knob] = FMath::Lerp(Info.Min, Info.Max, T);
+                Rest /= GridLevels;
+            }
+            C.Params.Clamp();
+            Grid.Add(C);
+        }
+
+        EvaluateAll(Grid, Base, TraceViews);
+        NumEvaluated += Grid.Num();
+        UpdateFront(Front, Grid);
+        UE_LOG(LogTemp, Display, TEXT("Grid: %d configs, front=%d"), Grid.Num(), Front.Num());
+    }
+
+    // -------- Refinement: mutate Pareto members with a shrinking step --------
+    // A cheap stand-in for model-based (Bayesian) search that needs no surrogate fitting.
+    if (Front.Num() == 0)
+        Front = Baseline; // nothing matched yet, mutate from the baseline
+
+    FRandomStream Rng(Seed);
+    for (int32 Round = 0; Round < Rounds; ++Round)
+    {
+        const float StepScale = 0.15f * FMath::Pow(0.6f, float(Round));
+
+        TArray<FCandidate> Children;
+        Children.Reserve(PerRound);
+        for (int32 i = 0; i < PerRound; ++i)
+        {
+            FCandidate C = Front[Rng.RandHelper(Front.Num())];
+            for (int32 k = 0; k < FFlickTuningParams::Num; ++k)
+            {
+                const FFlickTuningParams::FKnobInfo& Info = FFlickTuningParams::GetKnobInfo(k);
+                C.Params.Values[k] += Gaussian(Rng) * StepScale * (Info.Max - Info.Min);
+            }
+            C.Params.Clamp();
+            Children.Add(C);
+        }
+
+        EvaluateAll(Children, Base, TraceViews);
+        NumEvaluated += Children.Num();
+        UpdateFront(Front, Children);
+        UE_LOG(LogTemp, Display, TEXT("Round %d: step %.3f, front=%d"), Round + 1, StepScale, Front.Num());
+    }
+
+    const double Elapsed = FPlatformTime::Seconds() - StartTime;
+    UE_LOG(LogTemp, Display, TEXT("Evaluated %lld configs in %.1fs (%.0f configs/s on %d workers)"),
+        NumEvaluated, Elapsed, NumEvaluated / FMath::Max(Elapsed, 1e-3), FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+
+    // -------- Output --------
+    Front.Sort([](const FCandidate& A, const FCandidate& B) { return A.Score.F1() > B.Score.F1(); });
+
+    FString Csv = TEXT("precision,recall,f1,latency_ms,tp,fp,fn");
+    for (int32 k = 0; k < FFlickTuningParams::Num; ++k)
+        Csv += FString::Printf(TEXT(",%s"), FFlickTuningParams::GetKnobInfo(k).Name);
+    Csv += TEXT("\n");
+
+    for (const FCandidate& C : Front)
+    {
+        Csv += FString::Printf(TEXT("%.4f,%.4f,%.4f,%.2f,%d,%d,%d"), C.Score.Precision(), C.Score.Recall(), C.Score.F1(),
+            C.Score.MeanLatencyMs(), C.Score.TruePositives, C.Score.FalsePositives, C.Score.FalseNegatives);
+        for (int32 k = 0; k < FFlickTuningParams::Num; ++k)
+            Csv += FString::Printf(TEXT(",%.5g"), C.Params.Values[k]);
+        Csv += TEXT("\n");
+    }
+
+    if (!FFileHelper::SaveStringToFile(Csv, *OutPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Cannot write %s"), *OutPath);
+        return 1;
+    }
+
+    const FCandidate& Best = Front[0];
+    UE_LOG(LogTemp, Display, TEXT("Pareto front (%d configs) written to %s"), Front.Num(), *OutPath);
+    UE_LOG(LogTemp, Display, TEXT("Best F1: P=%.3f R=%.3f F1=%.3f latency=%.1fms"),
+        Best.Score.Precision(), Best.Score.Recall(), Best.Score.F1(), Best.Score.MeanLatencyMs());
+    for (int32 k = 0; k < FFlickTuningParams::Num; ++k)
+        UE_LOG(LogTemp, Display, TEXT("  %-16s %.5g"), FFlickTuningParams::GetKnobInfo(k).Name, Best.Params.Values[k]);
+
+    return 0;
+}
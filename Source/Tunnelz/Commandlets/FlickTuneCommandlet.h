@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "FlickTuneCommandlet.generated.h"
+
+// Multi-core search over the flick tunables, scored on labeled traces.
+// UnrealEditor-Cmd Tunnelz.uproject -run=FlickTune -Traces=<dir> [-Pawn=<class path>]
+//     [-Grid=3] [-GridKnobs=StartRateRad,EndRateRad,MaxDuration,Deadzone]
+//     [-Rounds=8] [-PerRound=2000] [-Seed=1] [-Out=<pareto.csv>]
+// Writes the precision / recall / latency Pareto front as CSV.
+UCLASS()
+class TUNNELZ_API UFlickTuneCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UFlickTuneCommandlet();
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,22 @@
+#include "GestureBenchmarkCommandlet.h"
+
+#include "../Gesture/GestureBenchmark.h"
+
+UGestureBenchmarkCommandlet::UGestureBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UGestureBenchmarkCommandlet::Main(const FString& Params)
+{
+    int32 Axes = 8;
+    int32 Steps = 200000;
+    FParse::Value(*Params, TEXT("Axes="), Axes);
+    FParse::Value(*Params, TEXT("Steps="), Steps);
+
+    GestureBenchmark::RunAll(Axes, Steps, *GLog);
+    return 0;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GestureBenchmarkCommandlet.generated.h"
+
+// Headless gesture DSP microbenchmark.
+// UnrealEditor-Cmd Tunnelz.uproject -run=GestureBenchmark [-Axes=8] [-Steps=200000]
+UCLASS()
+class TUNNELZ_API UGestureBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGestureBenchmarkCommandlet();
+    virtual int32 Main(const FString& Params) override;
+};
@@ -1,12 +1,25 @@
 #include "EnemyActor.h"
-#include "Kismet/GameplayStatics.h"
+#include "Materials/MaterialInstanceDynamic.h"
 
-#include "../GameMode/MainGameMode.h"
+#include "EnemyRegistry.h"
+#include "EnemySimSubsystem.h"
+#include "SpinActorComponent.h"
+#include "TunnellerActorComponent.h"
+
+namespace
+{
+	// Components whose per-frame work UEnemySimSubsystem does in bulk
+	bool IsBatchSimulated(const UActorComponent* Component)
+	{
+		return Component->IsA<UTunnellerActorComponent>() || Component->IsA<USpinActorComponent>();
+	}
+}
 
 // Sets default values
 AEnemyActor::AEnemyActor()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Movement, spin and culling run in UEnemySimSubsystem; there is no actor tick, so Blueprint Event Tick never fires
+	PrimaryActorTick.bCanEverTick = false;
 
 	Tags.Add(FName("Enemy"));
 
@@ -21,58 +34,72 @@ void AEnemyActor::BeginPlay()
 {
 	Super::BeginPlay();
 
+	if (UEnemyRegistry* Registry = GetWorld()->GetSubsystem<UEnemyRegistry>())
+		Registry->Add(this);
+
+	UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>();
 	if (UStaticMeshComponent* Mesh = FindComponentByClass<UStaticMeshComponent>())
 	{
-		// Slot 0 is the first material on the mesh
-		UMaterialInterface* BaseMat = Mesh->GetMaterial(0);
-		DynMat = UMaterialInstanceDynamic::Create(BaseMat, this);
-
-		// Assign the dynamic material back to the mesh
-		Mesh->SetMaterial(0, DynMat);
-	}
-}
+		bRenderInstanced = bInstancedRendering && Sim && Mesh->GetStaticMesh() && UEnemySimSubsystem::IsInstancingEnabled();
+		if (bRenderInstanced)
+		{
+			// The subsystem's instanced mesh draws this enemy; frozen visuals go to its custom data
+			Mesh->SetVisibility(false);
+		}
+		else
+		{
+			// Slot 0 is the first material on the mesh
+			UMaterialInterface* BaseMat = Mesh->GetMaterial(0);
+			DynMat = UMaterialInstanceDynamic::Create(BaseMat, this);
 
-// Called every frame
-void AEnemyActor::Tick(float DeltaTime)
-{
-	if (IsPendingKillPending())
-		return;
+			// Assign the dynamic material back to the mesh
+			Mesh->SetMaterial(0, DynMat);
+		}
 
-	Super::Tick(DeltaTime);
+		DefaultCollisionProfile = Mesh->GetCollisionProfileName();
+	}
 
-	// Destroy self if gone behind player
-	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
-	if (PlayerPawn)
+	if (Sim)
 	{
-		if (GetActorLocation().X < PlayerPawn->GetActorLocation().X)
+		for (UActorComponent* Component : GetComponents())
 		{
-			AMainGameMode* GM = Cast<AMainGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
-			if (GM)
-				GM->OnActiveEnemyDestroyed(this); // still need to notify GM so it has proper alive enemy count
-
-			PrimaryActorTick.bCanEverTick = false;
-			Destroy();
+			if (IsBatchSimulated(Component))
+				Component->SetComponentTickEnabled(false);
 		}
+		Sim->Register(this);
 	}
 }
 
+void AEnemyActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>())
+		Sim->Unregister(this);
+	if (UEnemyRegistry* Registry = GetWorld()->GetSubsystem<UEnemyRegistry>())
+		Registry->Remove(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AEnemyActor::Freeze()
 {
-	if (ActorHasTag("Frozen"))
+	if (State != EEnemyState::Active)
 		return;
 
-	AMainGameMode* GM = Cast<AMainGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
-	if (GM)
-		GM->OnActiveEnemyDestroyed(this);
+	// Moving to the frozen set is what stops it counting as an active enemy
+	if (UEnemyRegistry* Registry = GetWorld()->GetSubsystem<UEnemyRegistry>())
+		Registry->SetState(this, EEnemyState::Frozen);
+	else
+		State = EEnemyState::Frozen;
 
-	// Ensure adding the Frozen tag comes after OnActiveEnemyDestroyed() call.
-	// OnActiveEnemyDestroyed() will not decrement active enemies if passed in actor has Frozen tag.
-	Tags.Add(FName("Frozen"));
+	UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>();
+	if (Sim)
+		Sim->SetFrozen(this, true);
 
 	// Set frozen material visuals
 	if (DynMat)
 	{
-		DynMat->SetScalarParameterValue(FName("Dithering"), -0.1f);
+		if (!Sim || Sim->UsesFrozenDithering())
+			DynMat->SetScalarParameterValue(FName("Dithering"), FrozenDithering);
 		DynMat->SetVectorParameterValue(FName("BaseTint"), FrozenTintColor);
 	}
 
@@ -83,3 +110,61 @@ void AEnemyActor::Freeze()
 	}
 }
 
+void AEnemyActor::ActivateFromPool(const FVector& Location, const FRotator& Rotation)
+{
+	bInPool = false;
+	++SpawnGeneration;
+	Tags.AddUnique(FName("Enemy"));
+	if (UEnemyRegistry* Registry = GetWorld()->GetSubsystem<UEnemyRegistry>())
+		Registry->Add(this);
+
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>();
+	for (UActorComponent* Component : GetComponents())
+	{
+		if (Component->PrimaryComponentTick.bCanEverTick && !(Sim && IsBatchSimulated(Component)))
+			Component->SetComponentTickEnabled(true);
+	}
+
+	// Aim at the player from the new spawn point
+	if (UTunnellerActorComponent* Tunneller = FindComponentByClass<UTunnellerActorComponent>())
+		Tunneller->ResetForSpawn();
+
+	if (Sim)
+		Sim->Register(this);
+
+	OnPoolActivated();
+}
+
+void AEnemyActor::DeactivateToPool()
+{
+	bInPool = true;
+
+	if (UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>())
+		Sim->Unregister(this);
+	if (UEnemyRegistry* Registry = GetWorld()->GetSubsystem<UEnemyRegistry>())
+		Registry->Remove(this); // also undoes Freeze()'s state
+	State = EEnemyState::Pooled;
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	for (UActorComponent* Component : GetComponents())
+		Component->SetComponentTickEnabled(false);
+
+	// Pooled enemies drop the Enemy tag so tag queries only see live ones
+	Tags.Remove(FName("Enemy"));
+
+	if (DynMat)
+		DynMat->ClearParameterValues(); // back to the base material's Dithering / BaseTint
+
+	if (UStaticMeshComponent* Mesh = FindComponentByClass<UStaticMeshComponent>())
+	{
+		if (!DefaultCollisionProfile.IsNone())
+			Mesh->SetCollisionProfileName(DefaultCollisionProfile);
+	}
+}
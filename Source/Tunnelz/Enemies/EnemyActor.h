@@ -5,6 +5,14 @@
 #include "GameFramework/Actor.h"
 #include "EnemyActor.generated.h"
 
+UENUM(BlueprintType)
+enum class EEnemyState : uint8
+{
+	Pooled, // not in play (in the pool, or not begun play yet)
+	Active, // counts towards the level's MaxNumActiveEnemies
+	Frozen, // collectible; no longer counts as active
+};
+
 UCLASS()
 class TUNNELZ_API AEnemyActor : public AActor
 {
@@ -15,21 +23,58 @@ public:
 	AEnemyActor();
 
 	UFUNCTION(BlueprintCallable) void Freeze();
+	UFUNCTION(BlueprintPure) EEnemyState GetState() const { return State; }
+	UFUNCTION(BlueprintPure) bool IsFrozen() const { return State == EEnemyState::Frozen; }
+	static constexpr float FrozenDithering = -0.1f;
+
+	// Pool lifecycle (see UEnemyPool). Deactivating hides the enemy, stops its ticks and collision
+	// and undoes Freeze(); activating places it and re-runs per-spawn setup.
+	void ActivateFromPool(const FVector& Location, const FRotator& Rotation);
+	void DeactivateToPool();
+	bool IsInPool() const { return bInPool; }
+
+	// Bumped each time the pool hands the actor out, so snapshots of an earlier life can tell it's gone
+	uint32 GetSpawnGeneration() const { return SpawnGeneration; }
+
+	// Per-spawn Blueprint setup; BeginPlay only runs once for a pooled enemy
+	UFUNCTION(BlueprintImplementableEvent) void OnPoolActivated();
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Components")
 	UStaticMeshComponent* MeshComponent = nullptr;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Visuals")
 	FVector FrozenTintColor = FVector(1.f, 0.f, 0.f);
 
+	// Draw through one instanced mesh shared by every enemy with the same mesh and material instead of
+	// a per-enemy mesh + dynamic material. The material must read PerInstanceCustomData 0 as Dithering
+	// and 1-3 as BaseTint (4-7 carry material spin, see USpinActorComponent::bSpinInMaterial).
+	// Collision still uses MeshComponent, which stays invisible.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Visuals")
+	bool bInstancedRendering = false;
+
+	bool UsesInstancedRendering() const { return bRenderInstanced; }
+
 private:
+	UPROPERTY(Transient)
 	UMaterialInstanceDynamic* DynMat = nullptr;
+
+	FName DefaultCollisionProfile;
+	bool bInPool = false;
+	bool bRenderInstanced = false;
+	uint32 SpawnGeneration = 0;
+
+	// Set by UEnemyRegistry; RegistryIndex is the slot in the set for State
+	friend class UEnemyRegistry;
+	EEnemyState State = EEnemyState::Pooled;
+	int32 RegistryIndex = INDEX_NONE;
+
+	// Slot in UEnemySimSubsystem, which moves, spins and culls the enemy instead of per-actor ticks
+	friend class UEnemySimSubsystem;
+	int32 SimIndex = INDEX_NONE;
 };
@@ -0,0 +1,106 @@
+#include "EnemyLaneIndex.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+
+#include "EnemyActor.h"
+
+void FEnemyLaneIndex::Reset(const FLaneLayout& InLayout)
+{
+	Layout = InLayout;
+	Layout.NumLanes = FMath::Max(Layout.NumLanes, 1);
+	Layout.LaneWidth = FMath::Max(Layout.LaneWidth, UE_KINDA_SMALL_NUMBER);
+
+	if (Lanes.Num() != Layout.NumLanes)
+		Lanes.SetNum(Layout.NumLanes);
+	for (TArray<FEntry>& Lane : Lanes)
+		Lane.Reset();
+	MaxRadius = 0.f;
+}
+
+void FEnemyLaneIndex::Add(const FVector& Position, float Radius, AEnemyActor* Enemy)
+{
+	FEntry& Entry = Lanes[Layout.GetLaneAt(Position.Y)].AddDefaulted_GetRef();
+	Entry.X = Position.X;
+	Entry.Y = float(Position.Y);
+	Entry.Z = float(Position.Z);
+	Entry.Radius = Radius;
+	Entry.Enemy = Enemy;
+	Entry.Generation = Enemy->GetSpawnGeneration();
+	MaxRadius = FMath::Max(MaxRadius, Radius);
+}
+
+void FEnemyLaneIndex::Finalize()
+{
+	for (TArray<FEntry>& Lane : Lanes)
+		Algo::SortBy(Lane, &FEntry::X);
+}
+
+AEnemyActor* FEnemyLaneIndex::GetLive(const FEntry& Entry)
+{
+	AEnemyActor* Enemy = Entry.Enemy.Get();
+	return IsValid(Enemy) && Enemy->GetState() != EEnemyState::Pooled && Enemy->GetSpawnGeneration() == Entry.Generation ? Enemy : nullptr;
+}
+
+int32 FEnemyLaneIndex::LowerBound(int32 Lane, double X) const
+{
+	return Algo::LowerBoundBy(Lanes[Lane], X, &FEntry::X);
+}
+
+void FEnemyLaneIndex::GatherInRadius(const FVector& Center, float Radius, bool bIncludeFrozen, TArray<AEnemyActor*>& Out) const
+{
+	if (Lanes.Num() == 0)
+		return;
+
+	// Enemies are bucketed by their centre, so widen by the largest radius to catch ones straddling a lane edge
+	const float Reach = Radius + MaxRadius;
+	const int32 FirstLane = Layout.GetLaneAt(Center.Y - Reach);
+	const int32 LastLane = Layout.GetLaneAt(Center.Y + Reach);
+
+	for (int32 Lane = FirstLane; Lane <= LastLane; ++Lane)
+	{
+		const TArray<FEntry>& Entries = Lanes[Lane];
+		for (int32 i = LowerBound(Lane, Center.X - Reach); i < Entries.Num() && Entries[i].X <= Center.X + Reach; ++i)
+		{
+			const FEntry& E = Entries[i];
+			const FVector Delta(E.X - Center.X, E.Y - Center.Y, E.Z - Center.Z);
+			if (Delta.SizeSquared() > FMath::Square(Radius + E.Radius))
+				continue;
+			AEnemyActor* Enemy = GetLive(E);
+			if (!Enemy || (!bIncludeFrozen && Enemy->IsFrozen()))
+				continue;
+			Out.Add(Enemy);
+		}
+	}
+}
+
+AEnemyActor* FEnemyLaneIndex::FindNearestThreat(int32 Lane, double X, double* OutDistance) const
+{
+	if (!Lanes.IsValidIndex(Lane))
+		return nullptr;
+
+	const TArray<FEntry>& Entries = Lanes[Lane];
+	for (int32 i = LowerBound(Lane, X); i < Entries.Num(); ++i)
+	{
+		const FEntry& E = Entries[i];
+		AEnemyActor* Enemy = GetLive(E);
+		if (Enemy && !Enemy->IsFrozen())
+		{
+			if (OutDistance)
+				*OutDistance = E.X - X;
+			return Enemy;
+		}
+	}
+	return nullptr;
+}
+
+void FEnemyLaneIndex::ForEachFrom(double MinX, TFunctionRef<void(const FEntry&)> Visit) const
+{
+	for (int32 Lane = 0; Lane < Lanes.Num(); ++Lane)
+	{
+		for (int32 i = LowerBound(Lane, MinX); i < Lanes[Lane].Num(); ++i)
+		{
+			if (GetLive(Lanes[Lane][i]))
+				Visit(Lanes[Lane][i]);
+		}
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AEnemyActor;
+
+// Lanes are equal-width strips across the arena's Y axis, centred on Y = 0
+struct FLaneLayout
+{
+	int32 NumLanes = 2;
+	float LaneWidth = 1.f;
+
+	float GetCenterY(int32 Lane) const
+	{
+		return (float(Lane) - 0.5f * float(NumLanes - 1)) * LaneWidth;
+	}
+
+	int32 GetLaneAt(double Y) const
+	{
+		return FMath::Clamp(FMath::FloorToInt32(float(Y / LaneWidth) + 0.5f * float(NumLanes)), 0, NumLanes - 1);
+	}
+
+	int32 ClampLane(int32 Lane) const { return FMath::Clamp(Lane, 0, NumLanes - 1); }
+};
+
+// Live enemies bucketed by lane, each lane sorted by X, rebuilt once per frame by UEnemySimSubsystem.
+// Queries binary-search the X range instead of asking physics. Entries are a snapshot: an enemy
+// released or destroyed since the last rebuild is skipped (entries hold it weakly, so one garbage
+// collected in between is safe too), as is one the pool has handed out again since, whose entry is
+// from its previous life. Frozen state is read live.
+class TUNNELZ_API FEnemyLaneIndex
+{
+public:
+	struct FEntry
+	{
+		double X = 0.0;
+		float Y = 0.f;
+		float Z = 0.f;
+		float Radius = 0.f; // bounding sphere
+		TWeakObjectPtr<AEnemyActor> Enemy;
+		uint32 Generation = 0; // AEnemyActor::GetSpawnGeneration when added
+	};
+
+	void Reset(const FLaneLayout& InLayout);
+	void Add(const FVector& Position, float Radius, AEnemyActor* Enemy);
+	void Finalize(); // sorts the lanes; call after the Adds
+
+	const FLaneLayout& GetLayout() const { return Layout; }
+
+	// Enemies whose bounding sphere touches the sphere at Center
+	void GatherInRadius(const FVector& Center, float Radius, bool bIncludeFrozen, TArray<AEnemyActor*>& Out) const;
+
+	// Closest active enemy in the lane at or ahead of X (null if none)
+	AEnemyActor* FindNearestThreat(int32 Lane, double X, double* OutDistance = nullptr) const;
+
+	// Every live entry (active or frozen) with X at or above MinX
+	void ForEachFrom(double MinX, TFunctionRef<void(const FEntry&)> Visit) const;
+
+private:
+	static AEnemyActor* GetLive(const FEntry& Entry); // null once released, re-spawned or destroyed
+	int32 LowerBound(int32 Lane, double X) const;
+
+	FLaneLayout Layout;
+	TArray<TArray<FEntry>> Lanes;
+	float MaxRadius = 0.f;
+};
@@ -0,0 +1,175 @@
+#include "EnemyPool.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+
+#include "EnemyActor.h"
+#include "../GameMode/MainGameMode.h"
+
+namespace
+{
+	// Prewarmed enemies spawn here, out of the arena, so their one frame of collision can't touch anything
+	const FVector PoolParkingLocation(0.f, 0.f, -100000.f);
+
+	// Applies the class' spawn collision handling the way SpawnActor would; false = don't spawn here
+	bool ResolveSpawnPoint(UWorld* World, const AEnemyActor* Template, FVector& Location, const FRotator& Rotation)
+	{
+		switch (Template->SpawnCollisionHandlingMethod)
+		{
+		case ESpawnActorCollisionHandlingMethod::DontSpawnIfColliding:
+			return !World->EncroachingBlockingGeometry(Template, Location, Rotation);
+		case ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding:
+			return World->FindTeleportSpot(Template, Location, Rotation);
+		case ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn:
+			World->FindTeleportSpot(Template, Location, Rotation);
+			return true;
+		default:
+			return true;
+		}
+	}
+}
+
+AEnemyActor* UEnemyPool::SpawnPooled(UWorld* World, TSubclassOf<AEnemyActor> Class, const FVector& Location, const FRotator& Rotation)
+{
+	// Collision handling was resolved by the caller
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AEnemyActor* Enemy = World->SpawnActor<AEnemyActor>(Class, Location, Rotation, Params);
+	if (Enemy)
+		Buckets.FindOrAdd(Class).All.Add(Enemy);
+	return Enemy;
+}
+
+int32 UEnemyPool::Prewarm(UWorld* World, TSubclassOf<AEnemyActor> Class, int32 Count, int32 MaxSpawns)
+{
+	if (!World || !*Class)
+		return 0;
+
+	FEnemyPoolBucket& Bucket = Buckets.FindOrAdd(Class);
+	Bucket.All.RemoveAll([](const TObjectPtr<AEnemyActor>& A) { return !IsValid(A); });
+	Bucket.Free.RemoveAll([](const TObjectPtr<AEnemyActor>& A) { return !IsValid(A); });
+
+	int32 NumSpawned = 0;
+	while (Bucket.All.Num() < Count && NumSpawned < MaxSpawns)
+	{
+		AEnemyActor* Enemy = SpawnPooled(World, Class, PoolParkingLocation, FRotator::ZeroRotator);
+		if (!Enemy)
+			break;
+
+		Enemy->DeactivateToPool();
+		Buckets.FindChecked(Class).Free.Add(Enemy);
+		++Stats.Prewarmed;
+		++NumSpawned;
+	}
+	return NumSpawned;
+}
+
+AEnemyActor* UEnemyPool::Acquire(UWorld* World, TSubclassOf<AEnemyActor> Class, const FVector& Location, const FRotator& Rotation)
+{
+	if (!World || !*Class)
+		return nullptr;
+
+	FVector SpawnLocation = Location;
+	if (!ResolveSpawnPoint(World, Class->GetDefaultObject<AEnemyActor>(), SpawnLocation, Rotation))
+	{
+		++Stats.Blocked;
+		return nullptr;
+	}
+
+	AEnemyActor* Enemy = nullptr;
+	if (FEnemyPoolBucket* Bucket = Buckets.Find(Class))
+	{
+		// Pooled actors can still be destroyed from outside (level teardown, Blueprint logic)
+		while (!Enemy && Bucket->Free.Num() > 0)
+		{
+			AEnemyActor* Candidate = Bucket->Free.Pop(EAllowShrinking::No);
+			if (IsValid(Candidate))
+				Enemy = Candidate;
+		}
+	}
+
+	if (Enemy)
+	{
+		Enemy->ActivateFromPool(SpawnLocation, Rotation);
+		++Stats.Hits;
+	}
+	else
+	{
+		Enemy = SpawnPooled(World, Class, SpawnLocation, Rotation);
+		if (!Enemy)
+			return nullptr;
+		++Stats.Misses;
+	}
+
+	++Stats.NumActive;
+	Stats.PeakActive = FMath::Max(Stats.PeakActive, Stats.NumActive);
+	return Enemy;
+}
+
+void UEnemyPool::Release(AEnemyActor* Enemy)
+{
+	if (!IsValid(Enemy) || Enemy->IsInPool())
+		return;
+
+	FEnemyPoolBucket* Bucket = Buckets.Find(Enemy->GetClass());
+	if (!Bucket)
+	{
+		// Not a pooled class (e.g. placed in the level)
+		Enemy->Destroy();
+		return;
+	}
+
+	if (!Bucket->All.Contains(Enemy))
+		Bucket->All.Add(Enemy);
+	else
+		--Stats.NumActive;
+
+	Enemy->DeactivateToPool();
+	Bucket->Free.Add(Enemy);
+	++Stats.Releases;
+}
+
+int32 UEnemyPool::NumPooled() const
+{
+	int32 Num = 0;
+	for (const TPair<TSubclassOf<AEnemyActor>, FEnemyPoolBucket>& Pair : Buckets)
+		Num += Pair.Value.All.Num();
+	return Num;
+}
+
+void UEnemyPool::ResetCounters()
+{
+	const int32 NumActive = Stats.NumActive;
+	Stats = FStats();
+	Stats.NumActive = NumActive;
+	Stats.PeakActive = NumActive;
+}
+
+void UEnemyPool::LogStats(FOutputDevice& Ar, const TCHAR* Context) const
+{
+	const int32 Requests = Stats.Hits + Stats.Misses;
+	Ar.Logf(TEXT("Enemy pool (%s): %d pooled, %d active (peak %d) | hits %d, misses %d (%.1f%% hit), blocked %d, releases %d, prewarmed %d"),
+		Context, NumPooled(), Stats.NumActive, Stats.PeakActive, Stats.Hits, Stats.Misses,
+		Requests > 0 ? 100.0 * Stats.Hits / Requests : 100.0, Stats.Blocked, Stats.Releases, Stats.Prewarmed);
+
+	for (const TPair<TSubclassOf<AEnemyActor>, FEnemyPoolBucket>& Pair : Buckets)
+		Ar.Logf(TEXT("  %-40s %3d pooled, %3d free"), *GetNameSafe(Pair.Key.Get()), Pair.Value.All.Num(), Pair.Value.Free.Num());
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GEnemyPoolStatsCmd(
+	TEXT("Tunnelz.Enemies.PoolStats"),
+	TEXT("Prints enemy pool hit/miss and spawn slot counters for the current run."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		AMainGameMode* GM = World ? Cast<AMainGameMode>(UGameplayStatics::GetGameMode(World)) : nullptr;
+		if (!GM || !GM->GetEnemyPool())
+		{
+			Ar.Log(TEXT("No enemy pool (not in a game world?)"));
+			return;
+		}
+		GM->GetEnemyPool()->LogStats(Ar, TEXT("current run"));
+		GM->LogSpawnStats(Ar);
+	}));
+#endif
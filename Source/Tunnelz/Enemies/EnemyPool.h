@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "EnemyPool.generated.h"
+
+class AEnemyActor;
+
+USTRUCT()
+struct FEnemyPoolBucket
+{
+	GENERATED_BODY()
+
+	// Deactivated actors ready to hand out
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AEnemyActor>> Free;
+
+	// Every actor this bucket ever created
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AEnemyActor>> All;
+};
+
+// Per-class pool of enemy actors. Reclaimed enemies are hidden, stop ticking and colliding, and
+// get their Frozen state, material parameters and collision profile reset instead of being destroyed.
+// Misses fall back to SpawnActor, so the pool only grows; a warmed steady-state run allocates no UObjects.
+UCLASS()
+class TUNNELZ_API UEnemyPool : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// Spawns until Class has at least Count pooled actors (active or free), at most MaxSpawns of them
+	// this call; returns how many it spawned
+	int32 Prewarm(UWorld* World, TSubclassOf<AEnemyActor> Class, int32 Count, int32 MaxSpawns = MAX_int32);
+
+	// Active enemy at Location, or null when the class blocks spawning there (DontSpawnIfColliding)
+	AEnemyActor* Acquire(UWorld* World, TSubclassOf<AEnemyActor> Class, const FVector& Location, const FRotator& Rotation);
+
+	// Returns an active enemy to its bucket; enemies the pool doesn't know are destroyed
+	void Release(AEnemyActor* Enemy);
+
+	struct FStats
+	{
+		int32 Hits = 0;       // handed out from a free list
+		int32 Misses = 0;     // had to spawn during play
+		int32 Blocked = 0;    // spawn point was occupied
+		int32 Prewarmed = 0;  // spawned by Prewarm
+		int32 Releases = 0;
+		int32 NumActive = 0;
+		int32 PeakActive = 0;
+	};
+	int32 NumPooled() const;
+	void ResetCounters();
+
+	void LogStats(FOutputDevice& Ar, const TCHAR* Context) const;
+
+private:
+	AEnemyActor* SpawnPooled(UWorld* World, TSubclassOf<AEnemyActor> Class, const FVector& Location, const FRotator& Rotation);
+
+	UPROPERTY(Transient)
+	TMap<TSubclassOf<AEnemyActor>, FEnemyPoolBucket> Buckets;
+
+	FStats Stats;
+};
@@ -0,0 +1,68 @@
+#include "EnemyRegistry.h"
+
+#include "EnemyActor.h"
+
+TArray<TObjectPtr<AEnemyActor>>* UEnemyRegistry::GetSet(EEnemyState State)
+{
+	switch (State)
+	{
+	case EEnemyState::Active: return &Active;
+	case EEnemyState::Frozen: return &Frozen;
+	default:                  return nullptr;
+	}
+}
+
+void UEnemyRegistry::RemoveFromSet(AEnemyActor* Enemy)
+{
+	TArray<TObjectPtr<AEnemyActor>>* Set = GetSet(Enemy->State);
+	if (!Set)
+		return;
+
+	const int32 Index = Enemy->RegistryIndex;
+	check(Set->IsValidIndex(Index) && (*Set)[Index] == Enemy);
+	Set->RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Set->IsValidIndex(Index))
+		(*Set)[Index]->RegistryIndex = Index;
+
+	Enemy->RegistryIndex = INDEX_NONE;
+}
+
+void UEnemyRegistry::Add(AEnemyActor* Enemy)
+{
+	if (!Enemy || Enemy->State != EEnemyState::Pooled)
+		return;
+
+	Enemy->State = EEnemyState::Active;
+	Enemy->RegistryIndex = Active.Add(Enemy);
+}
+
+void UEnemyRegistry::Remove(AEnemyActor* Enemy)
+{
+	if (!Enemy)
+		return;
+
+	RemoveFromSet(Enemy);
+	Enemy->State = EEnemyState::Pooled;
+}
+
+void UEnemyRegistry::SetState(AEnemyActor* Enemy, EEnemyState NewState)
+{
+	if (!Enemy || Enemy->State == NewState || Enemy->State == EEnemyState::Pooled)
+		return;
+
+	TArray<TObjectPtr<AEnemyActor>>* NewSet = GetSet(NewState);
+	if (!NewSet)
+	{
+		Remove(Enemy);
+		return;
+	}
+
+	RemoveFromSet(Enemy);
+	Enemy->State = NewState;
+	Enemy->RegistryIndex = NewSet->Add(Enemy);
+}
+
+bool UEnemyRegistry::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyRegistry.generated.h"
+
+class AEnemyActor;
+enum class EEnemyState : uint8;
+
+// Live enemies of a world, split into dense Active and Frozen sets. Add, Remove and state changes are
+// O(1) swap-removes (each enemy remembers its slot), so spawning logic, collection and resets only
+// touch the enemies they affect. Pooled enemies aren't registered.
+UCLASS()
+class TUNNELZ_API UEnemyRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// New or reactivated enemy; starts Active
+	void Add(AEnemyActor* Enemy);
+
+	// Enemy leaving play (pooled or destroyed); its state becomes Pooled
+	void Remove(AEnemyActor* Enemy);
+
+	// Active <-> Frozen
+	void SetState(AEnemyActor* Enemy, EEnemyState NewState);
+
+	int32 NumActive() const { return Active.Num(); }
+	int32 NumFrozen() const { return Frozen.Num(); }
+	TConstArrayView<TObjectPtr<AEnemyActor>> GetActive() const { return Active; }
+	TConstArrayView<TObjectPtr<AEnemyActor>> GetFrozen() const { return Frozen; }
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	TArray<TObjectPtr<AEnemyActor>>* GetSet(EEnemyState State);
+	void RemoveFromSet(AEnemyActor* Enemy);
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AEnemyActor>> Active;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AEnemyActor>> Frozen;
+};
@@ -0,0 +1,908 @@
+#include "EnemySimSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Math/RandomStream.h"
+
+#include "EnemyActor.h"
+#include "SpinActorComponent.h"
+#include "TunnellerActorComponent.h"
+#include "../GameMode/MainGameMode.h"
+#include "../Player/AMainPawn.h"
+
+static TAutoConsoleVariable<int32> CVarEnemyParallelThreshold(
+	TEXT("Tunnelz.Enemies.ParallelThreshold"),
+	128,
+	TEXT("Enemy count from which the batched enemy update is split across worker threads."));
+
+static TAutoConsoleVariable<int32> CVarEnemyInstanced(
+	TEXT("Tunnelz.Enemies.Instanced"),
+	1,
+	TEXT("Draw enemy classes with bInstancedRendering through shared instanced meshes (0 = always per-enemy meshes).\n")
+	TEXT("Read when an enemy is spawned."));
+
+static TAutoConsoleVariable<int32> CVarEnemyLOD(
+	TEXT("Tunnelz.Enemies.LOD"),
+	1,
+	TEXT("Significance LOD: write far or out-of-view enemies' transforms back less often and stop their spin.\n")
+	TEXT("Their simulated positions and collision stay exact. 0 = every enemy every step."));
+
+static TAutoConsoleVariable<float> CVarEnemyLODNearSec(
+	TEXT("Tunnelz.Enemies.LOD.NearSec"),
+	1.f,
+	TEXT("Enemies reaching the player within this many seconds are always written back (Near)."));
+
+static TAutoConsoleVariable<float> CVarEnemyLODFarSec(
+	TEXT("Tunnelz.Enemies.LOD.FarSec"),
+	3.f,
+	TEXT("Enemies further than this many seconds away, and beyond Tunnelz.Enemies.LOD.FarDistance, are Far."));
+
+static TAutoConsoleVariable<float> CVarEnemyLODNearDistance(
+	TEXT("Tunnelz.Enemies.LOD.NearDistance"),
+	800.f,
+	TEXT("Enemies closer than this (along the tunnel) are Near whatever their speed."));
+
+static TAutoConsoleVariable<float> CVarEnemyLODFarDistance(
+	TEXT("Tunnelz.Enemies.LOD.FarDistance"),
+	3000.f,
+	TEXT("Enemies further than this, and beyond Tunnelz.Enemies.LOD.FarSec, are Far."));
+
+static TAutoConsoleVariable<int32> CVarEnemyLODMidInterval(
+	TEXT("Tunnelz.Enemies.LOD.MidInterval"),
+	2,
+	TEXT("Mid enemies are written back every this many steps."));
+
+static TAutoConsoleVariable<int32> CVarEnemyLODFarInterval(
+	TEXT("Tunnelz.Enemies.LOD.FarInterval"),
+	4,
+	TEXT("Far enemies are written back every this many steps, and don't spin."));
+
+namespace
+{
+	constexpr int32 EnemySimChunkSize = 64;
+
+	// Game-thread inputs to the per-enemy significance test
+	struct FSignificanceView
+	{
+		bool bEnabled = false;
+		bool bHasCamera = false;
+		FVector CameraPos = FVector::ZeroVector;
+		FVector CameraDir = FVector::ForwardVector;
+		float CosHalfFov = -1.f;
+		float NearSec = 0.f;
+		float FarSec = 0.f;
+		float NearDistance = 0.f;
+		float FarDistance = 0.f;
+
+		static FSignificanceView Gather(const UWorld* World)
+		{
+			FSignificanceView View;
+			View.bEnabled = CVarEnemyLOD.GetValueOnGameThread() != 0;
+			View.NearSec = CVarEnemyLODNearSec.GetValueOnGameThread();
+			View.FarSec = CVarEnemyLODFarSec.GetValueOnGameThread();
+			View.NearDistance = CVarEnemyLODNearDistance.GetValueOnGameThread();
+			View.FarDistance = CVarEnemyLODFarDistance.GetValueOnGameThread();
+
+			const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+			if (PC && PC->PlayerCameraManager)
+			{
+				View.bHasCamera = true;
+				View.CameraPos = PC->PlayerCameraManager->GetCameraLocation();
+				View.CameraDir = PC->PlayerCameraManager->GetCameraRotation().Vector();
+				// FOV is horizontal; pad it so enemies at the edge of the screen count as in view
+				const float HalfFov = FMath::Min(PC->PlayerCameraManager->GetFOVAngle() * 0.5f + 10.f, 89.f);
+				View.CosHalfFov = FMath::Cos(FMath::DegreesToRadians(HalfFov));
+			}
+			return View;
+		}
+	};
+
+	// Write intervals per bucket, at least 1
+	void GetSignificanceIntervals(int32 (&Out)[UEnemySimSubsystem::NumSignificance])
+	{
+		Out[UEnemySimSubsystem::SigNear] = 1;
+		Out[UEnemySimSubsystem::SigMid] = FMath::Max(CVarEnemyLODMidInterval.GetValueOnGameThread(), 1);
+		Out[UEnemySimSubsystem::SigFar] = FMath::Max(CVarEnemyLODFarInterval.GetValueOnGameThread(), 1);
+	}
+}
+
+void UEnemySimSubsystem::Register(AEnemyActor* Enemy)
+{
+	if (!Enemy || Enemy->SimIndex != INDEX_NONE)
+		return;
+
+	uint8 EnemyFlags = Enemy->IsFrozen() ? Frozen : 0;
+	FVector MoveDir = FVector::ZeroVector;
+	float ActiveSpeed = 0.f;
+	float FrozenSpeed = 0.f;
+	if (const UTunnellerActorComponent* Tunneller = Enemy->FindComponentByClass<UTunnellerActorComponent>())
+	{
+		EnemyFlags |= Moves;
+		MoveDir = Tunneller->GetMoveDir();
+		ActiveSpeed = Tunneller->ActiveSpeed;
+		FrozenSpeed = Tunneller->FrozenSpeed;
+	}
+
+	FRotator SpinRate = FRotator::ZeroRotator;
+	if (const USpinActorComponent* Spin = Enemy->FindComponentByClass<USpinActorComponent>())
+	{
+		EnemyFlags |= Spin->bSpinInMaterial ? MaterialSpin : Spins;
+		SpinRate = Spin->DegreesPerSecond;
+	}
+
+	Enemy->SimIndex = Actors.Add(Enemy);
+	Positions.Add(Enemy->GetActorLocation());
+	Rotations.Add(Enemy->GetActorQuat());
+	PrevPositions.Add(Positions.Last());
+	PrevRotations.Add(Rotations.Last());
+	MoveDirs.Add(MoveDir);
+	SpinRates.Add(SpinRate);
+	SpinStartTimes.Add((EnemyFlags & MaterialSpin) ? GetWorld()->GetTimeSeconds() : 0.f);
+	ActiveSpeeds.Add(ActiveSpeed);
+	FrozenSpeeds.Add(FrozenSpeed);
+	Flags.Add(EnemyFlags);
+	Scales.Add(Enemy->GetActorScale3D());
+	Radii.Add(Enemy->MeshComponent ? float(Enemy->MeshComponent->Bounds.SphereRadius) : 0.f);
+	ImpactTimes.Add(TNumericLimits<double>::Max());
+	ComputeImpactTime(Enemy->SimIndex);
+	InstanceBatches.Add(INDEX_NONE);
+	InstanceSlots.Add(INDEX_NONE);
+	Significance.Add(SigNear);
+
+	if (Enemy->UsesInstancedRendering())
+	{
+		AcquireInstance(Enemy->SimIndex, Enemy);
+	}
+	else if ((EnemyFlags & MaterialSpin) && Enemy->MeshComponent)
+	{
+		// Set once per spawn (one render state update); the material does the rest
+		float Data[NumCustomData];
+		WriteSpinCustomData(Enemy->SimIndex, Data);
+		Enemy->MeshComponent->SetCustomPrimitiveDataVector4(CustomDataSpinStart, FVector4(
+			Data[CustomDataSpinStart], Data[CustomDataSpinRate + 0], Data[CustomDataSpinRate + 1], Data[CustomDataSpinRate + 2]));
+	}
+}
+
+void UEnemySimSubsystem::Unregister(AEnemyActor* Enemy)
+{
+	if (!Enemy || Enemy->SimIndex == INDEX_NONE)
+		return;
+
+	const int32 Index = Enemy->SimIndex;
+	check(Actors[Index] == Enemy);
+	Enemy->SimIndex = INDEX_NONE;
+
+	// Writeback can trigger hit/overlap events that release enemies; keep indices stable until it's done
+	if (bWritingBack)
+	{
+		Actors[Index] = nullptr;
+		Flags[Index] |= Removed;
+		++NumRemovedDuringWriteback;
+		return;
+	}
+
+	RemoveAtSwap(Index);
+}
+
+void UEnemySimSubsystem::RemoveAtSwap(int32 Index)
+{
+	ReleaseInstance(Index);
+
+	Actors.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Rotations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PrevPositions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PrevRotations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	MoveDirs.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SpinRates.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SpinStartTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ActiveSpeeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	FrozenSpeeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Flags.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Scales.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Radii.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ImpactTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	InstanceBatches.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	InstanceSlots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Significance.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	if (Actors.IsValidIndex(Index) && Actors[Index])
+		Actors[Index]->SimIndex = Index;
+}
+
+void UEnemySimSubsystem::SetFrozen(AEnemyActor* Enemy, bool bFrozen)
+{
+	if (!Enemy || Enemy->SimIndex == INDEX_NONE)
+		return;
+
+	uint8& EnemyFlags = Flags[Enemy->SimIndex];
+	EnemyFlags = bFrozen ? (EnemyFlags | Frozen) : (EnemyFlags & ~Frozen);
+	ComputeImpactTime(Enemy->SimIndex);
+
+	if (InstanceBatches[Enemy->SimIndex] != INDEX_NONE)
+		WriteInstanceCustomData(Enemy->SimIndex, Enemy);
+}
+
+// -------- Analytic collision --------
+
+void UEnemySimSubsystem::SetPlayerTarget(const FVector& Position, float Radius)
+{
+	PlayerTarget = Position;
+	PlayerRadius = Radius;
+	bHasPlayerTarget = true;
+
+	for (int32 i = 0; i < Actors.Num(); ++i)
+		ComputeImpactTime(i);
+}
+
+EEnemyCollisionMode UEnemySimSubsystem::GetCollisionMode() const
+{
+	if (ForcedCollisionMode.IsSet())
+		return ForcedCollisionMode.GetValue();
+
+	const AMainGameMode* GM = Cast<AMainGameMode>(GetWorld()->GetAuthGameMode());
+	return GM ? GM->EnemyCollisionMode : EEnemyCollisionMode::Sweep;
+}
+
+void UEnemySimSubsystem::ComputeImpactTime(int32 Index)
+{
+	double& ImpactTime = ImpactTimes[Index];
+	ImpactTime = TNumericLimits<double>::Max();
+
+	// Frozen enemies drift through the player harmlessly
+	const uint8 F = Flags[Index];
+	if (!bHasPlayerTarget || !(F & Moves) || (F & Frozen))
+		return;
+
+	// |Q + V t| = R, smallest t >= 0
+	const FVector Q = Positions[Index] - PlayerTarget;
+	const FVector V = MoveDirs[Index] * ActiveSpeeds[Index];
+	const double R = Radii[Index] + PlayerRadius;
+
+	const double C = Q.SizeSquared() - R * R;
+	if (C <= 0.0)
+	{
+		ImpactTime = SimTime; // already touching
+		return;
+	}
+
+	const double A = V.SizeSquared();
+	const double B = 2.0 * FVector::DotProduct(Q, V);
+	if (A < UE_SMALL_NUMBER || B >= 0.0)
+		return; // not closing in
+
+	const double Disc = B * B - 4.0 * A * C;
+	if (Disc < 0.0)
+		return; // passes by
+
+	ImpactTime = SimTime + (-B - FMath::Sqrt(Disc)) / (2.0 * A);
+}
+
+bool UEnemySimSubsystem::IsInstancingEnabled()
+{
+	return CVarEnemyInstanced.GetValueOnGameThread() != 0;
+}
+
+// -------- Instanced rendering --------
+
+int32 UEnemySimSubsystem::FindOrAddBatch(UStaticMesh* Mesh, UMaterialInterface* Material)
+{
+	const TPair<const UStaticMesh*, const UMaterialInterface*> Key(Mesh, Material);
+	if (const int32* Found = BatchLookup.Find(Key))
+		return *Found;
+
+	if (!InstanceHost)
+	{
+		FActorSpawnParameters Params;
+		Params.ObjectFlags |= RF_Transient;
+		InstanceHost = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+	}
+
+	UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(InstanceHost, NAME_None, RF_Transient);
+	Instances->SetMobility(EComponentMobility::Movable);
+	Instances->SetStaticMesh(Mesh);
+	Instances->SetMaterial(0, Material);
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision); // enemies collide through their own mesh component
+	Instances->SetNumCustomDataFloats(NumCustomData);
+	if (USceneComponent* Root = InstanceHost->GetRootComponent())
+		Instances->SetupAttachment(Root);
+	else
+		InstanceHost->SetRootComponent(Instances);
+	Instances->RegisterComponent();
+	InstanceHost->AddInstanceComponent(Instances);
+
+	FEnemyInstanceBatch& Batch = Batches.AddDefaulted_GetRef();
+	Batch.Mesh = Instances;
+
+	// Unfrozen look = the material's own parameter values, as with a fresh dynamic material
+	if (Material)
+	{
+		float Dithering;
+		if (Material->GetScalarParameterValue(FHashedMaterialParameterInfo(FName("Dithering")), Dithering))
+			Batch.DefaultCustomData[CustomDataDithering] = Dithering;
+
+		FLinearColor Tint;
+		if (Material->GetVectorParameterValue(FHashedMaterialParameterInfo(FName("BaseTint")), Tint))
+		{
+			Batch.DefaultCustomData[CustomDataTint + 0] = Tint.R;
+			Batch.DefaultCustomData[CustomDataTint + 1] = Tint.G;
+			Batch.DefaultCustomData[CustomDataTint + 2] = Tint.B;
+		}
+	}
+
+	return BatchLookup.Add(Key, Batches.Num() - 1);
+}
+
+void UEnemySimSubsystem::AcquireInstance(int32 Index, const AEnemyActor* Enemy)
+{
+	const UStaticMeshComponent* EnemyMesh = Enemy->MeshComponent;
+	if (!EnemyMesh || !EnemyMesh->GetStaticMesh())
+		return;
+
+	const int32 BatchIndex = FindOrAddBatch(EnemyMesh->GetStaticMesh(), EnemyMesh->GetMaterial(0));
+	FEnemyInstanceBatch& Batch = Batches[BatchIndex];
+
+	const FTransform Transform(Rotations[Index], Positions[Index], Scales[Index]);
+	int32 Slot;
+	if (Batch.FreeSlots.Num() > 0)
+	{
+		Slot = Batch.FreeSlots.Pop(EAllowShrinking::No);
+		Batch.Transforms[Slot] = Transform;
+		Batch.Mesh->UpdateInstanceTransform(Slot, Transform, true, true, true);
+	}
+	else
+	{
+		Slot = Batch.Mesh->AddInstance(Transform, true);
+		Batch.Transforms.Add(Transform);
+		check(Slot == Batch.Transforms.Num() - 1);
+	}
+
+	InstanceBatches[Index] = BatchIndex;
+	InstanceSlots[Index] = Slot;
+	WriteInstanceCustomData(Index, Enemy);
+}
+
+void UEnemySimSubsystem::ReleaseInstance(int32 Index)
+{
+	const int32 BatchIndex = InstanceBatches[Index];
+	if (BatchIndex == INDEX_NONE)
+		return;
+
+	FEnemyInstanceBatch& Batch = Batches[BatchIndex];
+	const int32 Slot = InstanceSlots[Index];
+
+	// Zero scale hides the slot until the next enemy takes it
+	const FTransform Hidden(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+	Batch.Transforms[Slot] = Hidden;
+	if (Batch.Mesh)
+		Batch.Mesh->UpdateInstanceTransform(Slot, Hidden, true, true, true);
+	Batch.FreeSlots.Add(Slot);
+
+	InstanceBatches[Index] = INDEX_NONE;
+	InstanceSlots[Index] = INDEX_NONE;
+}
+
+void UEnemySimSubsystem::WriteInstanceCustomData(int32 Index, const AEnemyActor* Enemy)
+{
+	FEnemyInstanceBatch& Batch = Batches[InstanceBatches[Index]];
+	if (!Batch.Mesh)
+		return;
+
+	float Data[NumCustomData];
+	if (Flags[Index] & Frozen)
+	{
+		Data[CustomDataDithering] = bFrozenDithering ? AEnemyActor::FrozenDithering : Batch.DefaultCustomData[CustomDataDithering];
+		Data[CustomDataTint + 0] = Enemy->FrozenTintColor.X;
+		Data[CustomDataTint + 1] = Enemy->FrozenTintColor.Y;
+		Data[CustomDataTint + 2] = Enemy->FrozenTintColor.Z;
+	}
+	else
+	{
+		FMemory::Memcpy(Data, Batch.DefaultCustomData, sizeof(Batch.DefaultCustomData));
+	}
+	WriteSpinCustomData(Index, Data);
+	Batch.Mesh->SetCustomData(InstanceSlots[Index], MakeArrayView(Data), true);
+}
+
+void UEnemySimSubsystem::WriteSpinCustomData(int32 Index, float* OutData) const
+{
+	const bool bMaterialSpin = (Flags[Index] & MaterialSpin) != 0;
+	const FRotator& Rate = SpinRates[Index];
+	OutData[CustomDataSpinStart] = bMaterialSpin ? SpinStartTimes[Index] : 0.f;
+	OutData[CustomDataSpinRate + 0] = bMaterialSpin ? float(Rate.Roll) : 0.f;
+	OutData[CustomDataSpinRate + 1] = bMaterialSpin ? float(Rate.Pitch) : 0.f;
+	OutData[CustomDataSpinRate + 2] = bMaterialSpin ? float(Rate.Yaw) : 0.f;
+}
+
+void UEnemySimSubsystem::SetFrozenDithering(bool bEnabled)
+{
+	if (bFrozenDithering == bEnabled)
+		return;
+	bFrozenDithering = bEnabled;
+
+	for (int32 i = 0; i < Actors.Num(); ++i)
+	{
+		if (!(Flags[i] & Frozen))
+			continue;
+		if (InstanceBatches[i] != INDEX_NONE)
+		{
+			WriteInstanceCustomData(i, Actors[i]);
+		}
+		else if (UMaterialInstanceDynamic* DynMat = Actors[i]->DynMat)
+		{
+			// Without frozen dithering it's the base material's own value, as when unfrozen
+			float Dithering = AEnemyActor::FrozenDithering;
+			if (!bEnabled && !(DynMat->Parent && DynMat->Parent->GetScalarParameterValue(FHashedMaterialParameterInfo(FName("Dithering")), Dithering)))
+				Dithering = 0.f;
+			DynMat->SetScalarParameterValue(FName("Dithering"), Dithering);
+		}
+	}
+}
+
+void UEnemySimSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!bManualStepping)
+		Step(DeltaTime);
+}
+
+void UEnemySimSubsystem::Step(float DeltaTime)
+{
+	const int32 NumEnemies = Actors.Num();
+	if (DeltaTime <= 0.f)
+		return;
+	if (NumEnemies == 0)
+	{
+		LastUpdateSec = LastWritebackSec = LastIndexSec = 0.0;
+		LastSignificance = FSignificanceStats();
+		RebuildLaneIndex();
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(World, 0);
+	const bool bHasPlayer = PlayerPawn != nullptr;
+	const double PlayerX = bHasPlayer ? PlayerPawn->GetActorLocation().X : 0.0;
+
+	const bool bAnalytic = GetCollisionMode() == EEnemyCollisionMode::Analytic;
+	if (bAnalytic && !bHasPlayerTarget && bHasPlayer)
+		SetPlayerTarget(PlayerPawn->GetActorLocation(), 0.f);
+
+	SimTime += DeltaTime;
+	FSignificanceView View = FSignificanceView::Gather(World);
+	if (bBenchmarking)
+		View.bEnabled = false; // both collision modes pay for every write
+
+	// -------- Update --------
+	double StartTime = FPlatformTime::Seconds();
+
+	Outcomes.SetNumUninitialized(NumEnemies, EAllowShrinking::No);
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumEnemies, EnemySimChunkSize);
+	ParallelFor(NumChunks, [this, DeltaTime, bHasPlayer, PlayerX, bAnalytic, NumEnemies, &View](int32 Chunk)
+	{
+		const int32 End = FMath::Min((Chunk + 1) * EnemySimChunkSize, NumEnemies);
+		for (int32 i = Chunk * EnemySimChunkSize; i < End; ++i)
+		{
+			const uint8 F = Flags[i];
+			PrevPositions[i] = Positions[i];
+			PrevRotations[i] = Rotations[i];
+			const float Speed = (F & Moves) ? ((F & Frozen) ? FrozenSpeeds[i] : ActiveSpeeds[i]) : 0.f;
+			if (F & Moves)
+				Positions[i] += MoveDirs[i] * (Speed * DeltaTime);
+
+			// Swept enemies are bucketed too: the LOD spaces out their rotation and instance writes, but
+			// every writeback still sweeps their location, since that is what collides
+			uint8 Sig = SigNear;
+			if (View.bEnabled && bHasPlayer)
+			{
+				const float Distance = float(Positions[i].X - PlayerX);
+				const float ClosingSpeed = -float(MoveDirs[i].X) * Speed;
+				const float TimeToPlayer = ClosingSpeed > KINDA_SMALL_NUMBER ? Distance / ClosingSpeed : TNumericLimits<float>::Max();
+				const bool bInView = !View.bHasCamera
+					|| FVector::DotProduct((Positions[i] - View.CameraPos).GetSafeNormal(), View.CameraDir) >= View.CosHalfFov;
+
+				if (Distance < View.NearDistance || TimeToPlayer < View.NearSec)
+					Sig = SigNear;
+				else if (!bInView || (Distance > View.FarDistance && TimeToPlayer > View.FarSec))
+					Sig = SigFar;
+				else
+					Sig = SigMid;
+			}
+			Significance[i] = Sig;
+
+			if ((F & Spins) && Sig != SigFar)
+				Rotations[i] = Rotations[i] * FQuat(SpinRates[i] * (DeltaTime * SpinScale)); // local-space spin
+			// Impact first: a fast enemy can pass the player's sphere and end up behind it in one step
+			Outcomes[i] = (bAnalytic && SimTime >= ImpactTimes[i]) ? Impact
+				: (bHasPlayer && Positions[i].X < PlayerX) ? Behind
+				: None;
+		}
+	}, NumEnemies < CVarEnemyParallelThreshold.GetValueOnGameThread() ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	LastUpdateSec = FPlatformTime::Seconds() - StartTime;
+
+	for (int32 s = 0; s < NumSignificance; ++s)
+		LastSignificance.Counts[s] = 0;
+	for (int32 i = 0; i < NumEnemies; ++i)
+		++LastSignificance.Counts[Significance[i]];
+	for (int32 s = 0; s < NumSignificance; ++s)
+		RunSignificance.Counts[s] = FMath::Max(RunSignificance.Counts[s], LastSignificance.Counts[s]);
+
+	// -------- Writeback --------
+	StartTime = FPlatformTime::Seconds();
+
+	// Actor and instance transforms are written (and swept) once per drawn frame by Interpolate instead
+	const bool bDeferTransforms = bRenderInterpolation;
+
+	int32 Intervals[NumSignificance];
+	GetSignificanceIntervals(Intervals);
+	const uint32 Phase = bDeferTransforms ? 0 : WritebackPhase++;
+	int32 NumWritten = 0;
+	int32 NumSkipped = 0;
+
+	ToRelease.Reset();
+	ToImpact.Reset();
+	bWritingBack = true;
+	for (int32 i = 0; i < NumEnemies; ++i)
+	{
+		AEnemyActor* Enemy = Actors[i];
+		if (!Enemy || (Flags[i] & Removed))
+			continue;
+
+		// Gone behind the player
+		if (Outcomes[i] == Behind)
+		{
+			ToRelease.Add(Enemy);
+			continue;
+		}
+
+		if (Outcomes[i] == Impact)
+		{
+			ToImpact.Add(Enemy);
+			ImpactTimes[i] = TNumericLimits<double>::Max(); // once per enemy
+		}
+
+		if (bDeferTransforms || !(Flags[i] & (Moves | Spins)))
+			continue;
+
+		// Mid/Far enemies take turns, spread over the interval by index; swept ones still sweep in between
+		const bool bWrite = (Phase + uint32(i)) % uint32(Intervals[Significance[i]]) == 0;
+		const bool bSweep = !bAnalytic && (Flags[i] & Moves);
+		if (bWrite)
+			++NumWritten;
+		else
+			++NumSkipped;
+		if (!bWrite && !bSweep)
+			continue;
+
+		if (bSweep)
+		{
+			// Swept like the old per-enemy tick, so hits still fire; a blocking hit stops it short
+			if (bWrite)
+				Enemy->SetActorLocationAndRotation(Positions[i], Rotations[i], true);
+			else
+				Enemy->SetActorLocation(Positions[i], true);
+			if (!(Flags[i] & Removed))
+				Positions[i] = Enemy->GetActorLocation();
+		}
+		else if (Flags[i] & Moves)
+		{
+			Enemy->SetActorLocationAndRotation(Positions[i], Rotations[i], false);
+		}
+		else
+		{
+			Enemy->SetActorRotation(Rotations[i]);
+		}
+
+		if (bWrite && InstanceBatches[i] != INDEX_NONE && !(Flags[i] & Removed))
+		{
+			FEnemyInstanceBatch& Batch = Batches[InstanceBatches[i]];
+			Batch.Transforms[InstanceSlots[i]] = FTransform(Rotations[i], Positions[i], Scales[i]);
+			Batch.bTransformsDirty = true;
+		}
+	}
+	bWritingBack = false;
+	if (!bDeferTransforms)
+		AddWritebackStats(NumWritten, NumSkipped, FPlatformTime::Seconds() - StartTime);
+	CompactRemoved();
+
+	// One transform upload per instanced mesh
+	for (FEnemyInstanceBatch& Batch : Batches)
+	{
+		if (Batch.bTransformsDirty && Batch.Mesh)
+			Batch.Mesh->BatchUpdateInstancesTransforms(0, Batch.Transforms, true, true, true);
+		Batch.bTransformsDirty = false;
+	}
+
+	AMainGameMode* GM = World ? Cast<AMainGameMode>(World->GetAuthGameMode()) : nullptr;
+	if (bBenchmarking)
+		ToRelease.Reset();
+	for (AEnemyActor* Enemy : ToRelease)
+	{
+		if (!IsValid(Enemy) || Enemy->IsInPool())
+			continue;
+
+		if (GM)
+			GM->ReleaseEnemy(Enemy);
+		else
+			Enemy->Destroy();
+	}
+
+	if (AMainPawn* MainPawn = Cast<AMainPawn>(PlayerPawn); MainPawn && !bBenchmarking)
+	{
+		for (AEnemyActor* Enemy : ToImpact)
+		{
+			if (IsValid(Enemy) && !Enemy->IsInPool())
+				MainPawn->OnEnemyImpact(Enemy);
+		}
+	}
+
+	LastWritebackSec = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	RebuildLaneIndex();
+	LastIndexSec = FPlatformTime::Seconds() - StartTime;
+}
+
+void UEnemySimSubsystem::Interpolate(float Alpha)
+{
+	if (!bRenderInterpolation)
+		return;
+
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bSweep = GetCollisionMode() == EEnemyCollisionMode::Sweep;
+	int32 Intervals[NumSignificance];
+	GetSignificanceIntervals(Intervals);
+	const uint32 Phase = WritebackPhase++;
+	int32 NumWritten = 0;
+	int32 NumSkipped = 0;
+
+	Alpha = FMath::Clamp(Alpha, 0.f, 1.f);
+	bWritingBack = true;
+	for (int32 i = 0; i < Actors.Num(); ++i)
+	{
+		AEnemyActor* Enemy = Actors[i];
+		if (!Enemy || (Flags[i] & Removed) || !(Flags[i] & (Moves | Spins)))
+			continue;
+		const bool bWrite = (Phase + uint32(i)) % uint32(Intervals[Significance[i]]) == 0;
+		const bool bSweepThis = bSweep && (Flags[i] & Moves);
+		if (bWrite)
+			++NumWritten;
+		else
+			++NumSkipped;
+		if (!bWrite && !bSweepThis)
+			continue;
+
+		FVector Position = FMath::Lerp(PrevPositions[i], Positions[i], double(Alpha));
+		const FQuat Rotation = FQuat::Slerp(PrevRotations[i], Rotations[i], Alpha);
+		if (bSweepThis)
+		{
+			// One sweep per drawn frame, from where it was drawn last, as the old per-enemy tick did; hits
+			// fire here. A blocking hit stops the simulated enemy too. Off its LOD turn only the location moves.
+			FHitResult Hit;
+			if (bWrite)
+				Enemy->SetActorLocationAndRotation(Position, Rotation, true, &Hit);
+			else
+				Enemy->SetActorLocation(Position, true, &Hit);
+			if (Flags[i] & Removed)
+				continue;
+			if (Hit.bBlockingHit)
+				Position = PrevPositions[i] = Positions[i] = Enemy->GetActorLocation();
+		}
+		else
+		{
+			Enemy->SetActorLocationAndRotation(Position, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+
+		if (bWrite && InstanceBatches[i] != INDEX_NONE)
+		{
+			FEnemyInstanceBatch& Batch = Batches[InstanceBatches[i]];
+			Batch.Transforms[InstanceSlots[i]] = FTransform(Rotation, Position, Scales[i]);
+			Batch.bTransformsDirty = true;
+		}
+	}
+	bWritingBack = false;
+	CompactRemoved();
+
+	for (FEnemyInstanceBatch& Batch : Batches)
+	{
+		if (Batch.bTransformsDirty && Batch.Mesh)
+			Batch.Mesh->BatchUpdateInstancesTransforms(0, Batch.Transforms, true, true, true);
+		Batch.bTransformsDirty = false;
+	}
+
+	AddWritebackStats(NumWritten, NumSkipped, FPlatformTime::Seconds() - StartTime);
+}
+
+void UEnemySimSubsystem::CompactRemoved()
+{
+	if (NumRemovedDuringWriteback == 0)
+		return;
+
+	for (int32 i = Actors.Num() - 1; i >= 0; --i)
+	{
+		if (Flags[i] & Removed)
+			RemoveAtSwap(i);
+	}
+	NumRemovedDuringWriteback = 0;
+}
+
+void UEnemySimSubsystem::AddWritebackStats(int32 Written, int32 Skipped, double LoopSec)
+{
+	LastSignificance.Written = Written;
+	LastSignificance.Skipped = Skipped;
+	LastSignificance.SavedSec = Written > 0 ? LoopSec * Skipped / Written : 0.0;
+
+	RunSignificance.Written += Written;
+	RunSignificance.Skipped += Skipped;
+	RunSignificance.SavedSec += LastSignificance.SavedSec;
+}
+
+void UEnemySimSubsystem::LogSignificanceStats(FOutputDevice& Ar) const
+{
+	const FSignificanceStats& L = LastSignificance;
+	const FSignificanceStats& R = RunSignificance;
+	Ar.Logf(TEXT("Enemy LOD%s: now %d near / %d mid / %d far, %lld written / %lld skipped last pass (~%.3f ms saved)"),
+		CVarEnemyLOD.GetValueOnGameThread() ? TEXT("") : TEXT(" (off)"),
+		L.Counts[SigNear], L.Counts[SigMid], L.Counts[SigFar], L.Written, L.Skipped, L.SavedSec * 1e3);
+	Ar.Logf(TEXT("  run: peak %d near / %d mid / %d far, %lld transform writes, %lld skipped (%.0f%%), ~%.1f ms saved"),
+		R.Counts[SigNear], R.Counts[SigMid], R.Counts[SigFar], R.Written, R.Skipped,
+		R.Written + R.Skipped > 0 ? 100.0 * R.Skipped / double(R.Written + R.Skipped) : 0.0, R.SavedSec * 1e3);
+}
+
+void UEnemySimSubsystem::RebuildLaneIndex()
+{
+	const AMainGameMode* GM = Cast<AMainGameMode>(GetWorld()->GetAuthGameMode());
+	LaneIndex.Reset(GM ? GM->GetLaneLayout() : FLaneLayout());
+
+	for (int32 i = 0; i < Actors.Num(); ++i)
+	{
+		if (Actors[i])
+			LaneIndex.Add(Positions[i], Radii[i], Actors[i]);
+	}
+	LaneIndex.Finalize();
+}
+
+// -------- Benchmark --------
+
+void UEnemySimSubsystem::RunCollisionBenchmark(TConstArrayView<int32> Counts, int32 Frames, FOutputDevice& Ar)
+{
+	UWorld* World = GetWorld();
+	AMainGameMode* GM = Cast<AMainGameMode>(World->GetAuthGameMode());
+	if (!GM || GM->IsPlaying())
+	{
+		Ar.Log(TEXT("Run this from the menu of a game world (it needs the game mode's levels and a paused run)."));
+		return;
+	}
+
+	// The first enemy class the levels can spawn
+	TSubclassOf<AEnemyActor> Class = AEnemyActor::StaticClass();
+	for (const FLevelProgression& Level : GM->Levels)
+	{
+		const FEnemyWeight* Weight = Level.EnemyWeights.FindByPredicate([](const FEnemyWeight& W) { return !W.Class.IsNull(); });
+		if (Weight)
+		{
+			Class = Weight->Class.LoadSynchronous();
+			break;
+		}
+	}
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(World, 0);
+	const FVector PlayerPos = bHasPlayerTarget ? PlayerTarget : (PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector);
+	const float Radius = PlayerRadius;
+	const FVector Arena = GM->ArenaSize;
+	const float Dt = 1.f / 60.f;
+	FRandomStream Rng(0x7E11);
+
+	// Every step writes every transform back in both modes, so they are compared like for like
+	TGuardValue<bool> Benchmarking(bBenchmarking, true);
+	TGuardValue<bool> NoInterpolation(bRenderInterpolation, false);
+
+	Ar.Logf(TEXT("Enemy collision benchmark: %s, %d frames per mode"), *GetNameSafe(Class.Get()), Frames);
+	for (const int32 Count : Counts)
+	{
+		// Ahead of the player, across the whole arena cross-section. Spawned outside the enemy pool so
+		// it doesn't keep thousands of benchmark enemies afterwards.
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Params.ObjectFlags |= RF_Transient;
+		TArray<AEnemyActor*> Spawned;
+		TArray<FVector> Starts;
+		for (int32 k = 0; k < Count; ++k)
+		{
+			const FVector Location(Rng.FRandRange(0.5f, 1.f) * Arena.X, Rng.FRandRange(-0.5f, 0.5f) * Arena.Y, Rng.FRandRange(-0.5f, 0.5f) * Arena.Z);
+			if (AEnemyActor* Enemy = World->SpawnActor<AEnemyActor>(Class, Location, FRotator::ZeroRotator, Params))
+			{
+				Spawned.Add(Enemy);
+				Starts.Add(Enemy->GetActorLocation());
+			}
+		}
+
+		double MsPerFrame[2] = {};
+		for (int32 Mode = 0; Mode < 2; ++Mode)
+		{
+			ForcedCollisionMode = EEnemyCollisionMode(Mode);
+
+			// Same starting state for both modes (nothing is released while benchmarking)
+			for (int32 k = 0; k < Spawned.Num(); ++k)
+			{
+				if (IsValid(Spawned[k]) && Spawned[k]->SimIndex != INDEX_NONE)
+				{
+					Spawned[k]->SetActorLocation(Starts[k]);
+					Positions[Spawned[k]->SimIndex] = Starts[k];
+				}
+			}
+			SetPlayerTarget(PlayerPos, Radius);
+
+			double Total = 0.0;
+			for (int32 f = 0; f < Frames; ++f)
+			{
+				Step(Dt);
+				Total += LastUpdateSec + LastWritebackSec + LastIndexSec;
+			}
+			MsPerFrame[Mode] = Total * 1e3 / FMath::Max(Frames, 1);
+		}
+		ForcedCollisionMode.Reset();
+
+		for (AEnemyActor* Enemy : Spawned)
+		{
+			if (IsValid(Enemy))
+				Enemy->Destroy();
+		}
+
+		Ar.Logf(TEXT("  %5d enemies (%5d spawned): sweep %8.3f ms/frame, analytic %8.3f ms/frame (%.1fx)"),
+			Count, Spawned.Num(), MsPerFrame[0], MsPerFrame[1], MsPerFrame[1] > 0.0 ? MsPerFrame[0] / MsPerFrame[1] : 0.0);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GEnemyLODStatsCmd(
+	TEXT("Tunnelz.Enemies.LODStats"),
+	TEXT("Prints enemy significance buckets (near/mid/far) and the transform writes the LOD skipped, for the last step and the run."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const UEnemySimSubsystem* Sim = World ? World->GetSubsystem<UEnemySimSubsystem>() : nullptr)
+			Sim->LogSignificanceStats(Ar);
+		else
+			Ar.Log(TEXT("No enemy simulation in this world."));
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GEnemyCollisionBenchCmd(
+	TEXT("Tunnelz.Bench.EnemyCollision"),
+	TEXT("Times the batched enemy update with swept vs analytic collision. Usage: Tunnelz.Bench.EnemyCollision [Count...] (default 50 500 5000; run from the menu)"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UEnemySimSubsystem* Sim = World ? World->GetSubsystem<UEnemySimSubsystem>() : nullptr;
+		if (!Sim)
+		{
+			Ar.Log(TEXT("No enemy simulation in this world."));
+			return;
+		}
+
+		TArray<int32> Counts;
+		for (const FString& Arg : Args)
+		{
+			if (Arg.IsNumeric())
+				Counts.Add(FMath::Max(FCString::Atoi(*Arg), 1));
+		}
+		if (Counts.Num() == 0)
+			Counts = { 50, 500, 5000 };
+
+		Sim->RunCollisionBenchmark(Counts, 120, Ar);
+	}));
+#endif
+
+TStatId UEnemySimSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySimSubsystem, STATGROUP_Tickables);
+}
+
+bool UEnemySimSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyLaneIndex.h"
+#include "EnemySimSubsystem.generated.h"
+
+class AEnemyActor;
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+
+UENUM(BlueprintType)
+enum class EEnemyCollisionMode : uint8
+{
+	Sweep,    // physics sweep per moving enemy per frame; hits come from the physics scene
+	Analytic, // closed-form time of impact with the player; no sweeps (see AMainPawn::OnEnemyImpact)
+};
+
+// One instanced mesh drawing every instanced enemy that shares a mesh and material.
+// Slots are recycled rather than removed (released ones are scaled to zero), so instance indices never shift.
+USTRUCT()
+struct FEnemyInstanceBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TObjectPtr<UInstancedStaticMeshComponent> Mesh = nullptr;
+
+	TArray<FTransform> Transforms; // world space, mirrors the instances
+	TArray<int32> FreeSlots;
+	float DefaultCustomData[4] = { 0.f, 1.f, 1.f, 1.f }; // unfrozen Dithering, BaseTint (spin data is per enemy)
+	bool bTransformsDirty = false;
+};
+
+// Moves, spins and culls every live enemy in one tick instead of three tick functions per enemy.
+// State lives in parallel arrays indexed by AEnemyActor::SimIndex: the update runs over them
+// (ParallelFor above Tunnelz.Enemies.ParallelThreshold), then a single game-thread pass writes the
+// transforms back and releases enemies that fell behind the player.
+// Tunneller/Spin settings are read when an enemy is registered (spawn or pool activation).
+// Enemies with bInstancedRendering are drawn through one FEnemyInstanceBatch per mesh/material,
+// with their frozen state and material spin in per-instance custom data (see CustomData*).
+// Spin components with bSpinInMaterial are never rotated on the CPU: their spawn time and rate are
+// written once and the enemy material turns the mesh with world position offset.
+// After the writeback the lane index is rebuilt for gameplay queries (lane-swap kills, threats).
+// In Analytic collision mode each enemy's straight-line path is solved against the player's sphere
+// once (on register, freeze and lane change) and the hit fires when the sim clock reaches it.
+// Significance LOD (Tunnelz.Enemies.LOD) buckets enemies every step by time to reach the player, distance
+// and whether they are in view; Mid and Far enemies have their transforms written back less often and
+// Far ones stop spinning. In Sweep mode moving enemies still sweep their location on every writeback; only
+// their rotation and instance transform wait. Positions, impact times and the lane index stay exact.
+UCLASS()
+class TUNNELZ_API UEnemySimSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void Register(AEnemyActor* Enemy);
+	void Unregister(AEnemyActor* Enemy);
+	void SetFrozen(AEnemyActor* Enemy, bool bFrozen);
+
+	// Where the player is, or is heading during a lane change; recomputes every impact time
+	void SetPlayerTarget(const FVector& Position, float Radius);
+
+	// The game mode's EnemyCollisionMode (Sweep without a game mode)
+	EEnemyCollisionMode GetCollisionMode() const;
+
+	// Advances every enemy by DeltaTime; Tick calls it unless stepping is manual
+	void Step(float DeltaTime);
+
+	// Manual: the frame tick does nothing and the owner calls Step (fixed-step loop, headless fast-forward)
+	void SetManualStepping(bool bManual) { bManualStepping = bManual; }
+
+	// Step leaves actor and instance transforms alone, and Interpolate places them between the last two
+	// steps once per drawn frame. In Sweep mode that is where moving enemies sweep (once per frame, however
+	// many steps ran). Gameplay queries always see the latest step.
+	void SetRenderInterpolation(bool bInterpolate) { bRenderInterpolation = bInterpolate; }
+	void Interpolate(float Alpha);
+
+	// Visual cost knobs (frame budget governor): spin speed multiplier, 0 = no spin; without frozen
+	// dithering frozen enemies keep their tint but draw solid
+	void SetSpinScale(float Scale) { SpinScale = FMath::Max(Scale, 0.f); }
+	void SetFrozenDithering(bool bEnabled);
+	bool UsesFrozenDithering() const { return bFrozenDithering; }
+
+	// Significance buckets; Near is written back every step
+	enum ESignificance : uint8 { SigNear, SigMid, SigFar, NumSignificance };
+
+	struct FSignificanceStats
+	{
+		int32 Counts[NumSignificance] = {}; // enemies per bucket (run stats: the most seen at once)
+		int64 Written = 0;     // actor/instance transform writes
+		int64 Skipped = 0;     // writes put off by the LOD
+		double SavedSec = 0.0; // estimate: skipped writes at the measured cost of the ones made
+	};
+	FSignificanceStats LastSignificance; // last step (counts) and last writeback (writes)
+	FSignificanceStats RunSignificance;  // since ResetSignificanceStats
+
+	void ResetSignificanceStats() { RunSignificance = FSignificanceStats(); }
+	void LogSignificanceStats(FOutputDevice& Ar) const;
+
+	// Times the same enemies under both collision modes, from the menu (Tunnelz.Bench.EnemyCollision)
+	void RunCollisionBenchmark(TConstArrayView<int32> Counts, int32 Frames, FOutputDevice& Ar);
+
+	// Enemy positions as of the end of the last sim tick, per lane
+	const FEnemyLaneIndex& GetLaneIndex() const { return LaneIndex; }
+
+	// Tunnelz.Enemies.Instanced; off makes every enemy use its own mesh and dynamic material
+	static bool IsInstancingEnabled();
+
+	// Per-instance custom data layout the enemy material reads. Spin goes to the same indices of the
+	// custom primitive data for enemies with their own mesh.
+	static constexpr int32 CustomDataDithering = 0;
+	static constexpr int32 CustomDataTint = 1;      // 3 floats
+	static constexpr int32 CustomDataSpinStart = 4; // world time (material Time) the spin starts from
+	static constexpr int32 CustomDataSpinRate = 5;  // 3 floats, deg/s about local X, Y, Z (roll, pitch, yaw); 0 = no spin
+	static constexpr int32 NumCustomData = 8;
+
+	// Last tick, for profiling
+	double LastUpdateSec = 0.0;
+	double LastWritebackSec = 0.0;
+	double LastIndexSec = 0.0;
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	enum EFlags : uint8
+	{
+		Moves   = 1 << 0, // has a Tunneller component
+		Spins   = 1 << 1, // has a Spin component
+		Frozen  = 1 << 2,
+		Removed = 1 << 3, // unregistered mid-writeback, compacted afterwards
+		MaterialSpin = 1 << 4, // Spin component with bSpinInMaterial; the CPU never rotates it
+	};
+
+	void RemoveAtSwap(int32 Index);
+	void CompactRemoved(); // drops enemies unregistered during a writeback
+	void RebuildLaneIndex();
+	void ComputeImpactTime(int32 Index);
+
+	int32 FindOrAddBatch(UStaticMesh* Mesh, UMaterialInterface* Material);
+	void AcquireInstance(int32 Index, const AEnemyActor* Enemy);
+	void ReleaseInstance(int32 Index);
+	void WriteInstanceCustomData(int32 Index, const AEnemyActor* Enemy);
+	void WriteSpinCustomData(int32 Index, float* OutData) const;
+	void AddWritebackStats(int32 Written, int32 Skipped, double LoopSec);
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AEnemyActor>> Actors;
+
+	TArray<FVector> Positions;
+	TArray<FQuat> Rotations;
+	TArray<FVector> PrevPositions; // before the last step, for render interpolation
+	TArray<FQuat> PrevRotations;
+	TArray<FVector> MoveDirs;
+	TArray<FRotator> SpinRates; // deg/s
+	TArray<float> SpinStartTimes; // MaterialSpin only
+	TArray<float> ActiveSpeeds;
+	TArray<float> FrozenSpeeds;
+	TArray<uint8> Flags;
+	TArray<FVector> Scales;
+	TArray<float> Radii;
+	TArray<double> ImpactTimes; // on the SimTime clock, max = never
+	TArray<int32> InstanceBatches; // INDEX_NONE = drawn by its own mesh component
+	TArray<int32> InstanceSlots;
+	TArray<uint8> Significance; // ESignificance, set every step
+
+	UPROPERTY(Transient)
+	TArray<FEnemyInstanceBatch> Batches;
+
+	TMap<TPair<const UStaticMesh*, const UMaterialInterface*>, int32> BatchLookup;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> InstanceHost = nullptr;
+
+	// Per-tick scratch, kept to avoid reallocating
+	enum EOutcome : uint8 { None, Behind, Impact };
+	TArray<uint8> Outcomes;
+	TArray<AEnemyActor*> ToRelease;
+	TArray<AEnemyActor*> ToImpact;
+
+	double SimTime = 0.0;
+	FVector PlayerTarget = FVector::ZeroVector;
+	float PlayerRadius = 0.f;
+	bool bHasPlayerTarget = false;
+
+	TOptional<EEnemyCollisionMode> ForcedCollisionMode; // benchmark
+	bool bBenchmarking = false; // no impact events, releases or LOD: every benchmark enemy stays simulated
+
+	FEnemyLaneIndex LaneIndex;
+
+	bool bWritingBack = false;
+	int32 NumRemovedDuringWriteback = 0;
+	bool bManualStepping = false;
+	bool bRenderInterpolation = false;
+
+	uint32 WritebackPhase = 0; // staggers Mid/Far writes across passes
+	float SpinScale = 1.f;
+	bool bFrozenDithering = true;
+};
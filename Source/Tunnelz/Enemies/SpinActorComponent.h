@@ -24,4 +24,11 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rotation")
 	FRotator DegreesPerSecond = FRotator(90.f, 90.f, 90.f);
+
+	// The enemy material spins the mesh with world position offset instead, from the spawn time and
+	// DegreesPerSecond passed once as custom data (see UEnemySimSubsystem::CustomDataSpinStart). The actor's
+	// rotation, and so its collision, stays as spawned. Without UEnemySimSubsystem the component still
+	// rotates the actor itself.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rotation")
+	bool bSpinInMaterial = false;
 };
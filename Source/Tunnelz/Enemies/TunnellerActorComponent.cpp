@@ -2,6 +2,7 @@
 #include "Kismet/GameplayStatics.h"
 
 #include "../Player/AMainPawn.h"
+#include "EnemyActor.h"
 
 
 UTunnellerActorComponent::UTunnellerActorComponent()
@@ -14,6 +15,11 @@ void UTunnellerActorComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+    ResetForSpawn();
+}
+
+void UTunnellerActorComponent::ResetForSpawn()
+{
     APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0);
     if (!PC) return;
 
@@ -36,7 +42,8 @@ void UTunnellerActorComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
     if (Owner)
     {
         float Speed = ActiveSpeed;
-        if (Owner->ActorHasTag("Frozen"))
+        const AEnemyActor* Enemy = Cast<AEnemyActor>(Owner);
+        if (Enemy && Enemy->IsFrozen())
             Speed = FrozenSpeed;
 
         Owner->SetActorLocation(Owner->GetActorLocation() + (MoveDirOnBeginPlay * Speed * DeltaTime), true);
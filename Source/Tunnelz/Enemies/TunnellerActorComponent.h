@@ -20,6 +20,10 @@ protected:
 public:
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	// Re-aims at the player from the owner's current location (BeginPlay, and each pooled respawn)
+	void ResetForSpawn();
+	FVector GetMoveDir() const { return MoveDirOnBeginPlay; }
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behavior")
 	float ActiveSpeed = 150.f;
 
@@ -29,5 +33,5 @@ public:
 private:
 	AMainPawn* MainPawnRef = nullptr;
 	FVector PlayerPosOnBeginPlay = FVector(0.f, 0.f, 0.f);
-	FVector MoveDirOnBeginPlay;
+	FVector MoveDirOnBeginPlay = FVector::ZeroVector;
 };
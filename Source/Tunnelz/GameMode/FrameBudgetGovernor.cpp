@@ -0,0 +1,54 @@
+#include "FrameBudgetGovernor.h"
+
+void FFrameBudgetGovernor::Reset()
+{
+    Density = 1.f;
+    LowestDensity = 1.f;
+    FrameMsAvg = 0.f;
+    GameThreadMsAvg = 0.f;
+    SinceAdjustSec = 0.f;
+    Adjustments = 0;
+    bHasSamples = false;
+}
+
+bool FFrameBudgetGovernor::Update(const FFrameBudgetSettings& Settings, float DeltaSec, float FrameMs, float GameThreadMs)
+{
+    if (DeltaSec <= 0.f)
+        return false;
+
+    if (!bHasSamples)
+    {
+        FrameMsAvg = FrameMs;
+        GameThreadMsAvg = GameThreadMs;
+        bHasSamples = true;
+    }
+    else
+    {
+        const float Alpha = 1.f - FMath::Exp(-DeltaSec / FMath::Max(Settings.SmoothingSec, 0.05f));
+        FrameMsAvg += (FrameMs - FrameMsAvg) * Alpha;
+        GameThreadMsAvg += (GameThreadMs - GameThreadMsAvg) * Alpha;
+    }
+
+    SinceAdjustSec += DeltaSec;
+    if (SinceAdjustSec < Settings.AdjustIntervalSec)
+        return false;
+
+    const float Over = Settings.TargetMs * (1.f + Settings.Hysteresis);
+    const float Under = Settings.TargetMs * (1.f - Settings.Hysteresis);
+    const float MinDensity = FMath::Clamp(Settings.MinDensity, 0.1f, 1.f);
+
+    float NewDensity = Density;
+    if (FrameMsAvg > Over || GameThreadMsAvg > Over)
+        NewDensity = FMath::Max(Density - Settings.DensityStep, MinDensity);
+    else if (GameThreadMsAvg < Under && FrameMsAvg <= Over)
+        NewDensity = FMath::Min(Density + Settings.DensityStep, 1.f);
+
+    if (FMath::IsNearlyEqual(NewDensity, Density))
+        return false;
+
+    Density = NewDensity;
+    LowestDensity = FMath::Min(LowestDensity, Density);
+    SinceAdjustSec = 0.f;
+    ++Adjustments;
+    return true;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FrameBudgetGovernor.generated.h"
+
+// Designer bounds for FFrameBudgetGovernor
+USTRUCT(BlueprintType)
+struct FFrameBudgetSettings
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frame Budget")
+    bool bEnabled = true;
+
+    // Frame time to hold: 16.6 for 60 fps, 11.1 for 90 fps
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frame Budget", meta = (ClampMin = "4.0"))
+    float TargetMs = 16.6f;
+
+    // Lowest spawn density the governor may go down to, as a fraction of the level's
+    // MaxNumActiveEnemies and of its spawn rate
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frame Budget", meta = (ClampMin = "0.1", ClampMax = "1.0"))
+    float MinDensity = 0.6f;
+
+    // Density change per adjustment
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frame Budget", meta = (ClampMin = "0.01", ClampMax = "1.0"))
+    float DensityStep = 0.1f;
+
+    // Dead band around TargetMs, as a fraction of it: load is shed above it and given back below it
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frame Budget", meta = (ClampMin = "0.0", ClampMax = "0.5"))
+    float Hysteresis = 0.1f;
+
+    // Minimum time between adjustments, so the averages see the last one's effect first
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frame Budget", meta = (ClampMin = "0.1"))
+    float AdjustIntervalSec = 2.f;
+
+    // Time constant of the frame and game-thread averages
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frame Budget", meta = (ClampMin = "0.05"))
+    float SmoothingSec = 0.5f;
+
+    // Enemies stop spinning below this density; 0 = never
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frame Budget", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float SpinOffBelowDensity = 0.f;
+
+    // Frozen enemies draw solid instead of dithered below this density; 0 = never
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frame Budget", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float FrozenDitherOffBelowDensity = 0.f;
+};
+
+// Steers spawn density from measured frame time. Frame and game-thread times are smoothed with an
+// exponential average; when either stays over TargetMs * (1 + Hysteresis) the density drops one step,
+// and when the game thread is back under TargetMs * (1 - Hysteresis) (and frames are within budget)
+// it rises one step, at most once per AdjustIntervalSec and never outside [MinDensity, 1].
+// Under vsync the frame time sits at the target, so only the game thread can tell there is headroom.
+class FFrameBudgetGovernor
+{
+public:
+    void Reset();
+
+    // One frame's measurements; true if the density changed
+    bool Update(const FFrameBudgetSettings& Settings, float DeltaSec, float FrameMs, float GameThreadMs);
+
+    float GetDensity() const { return Density; }
+    float GetLowestDensity() const { return LowestDensity; }
+    int32 NumAdjustments() const { return Adjustments; }
+    float GetSmoothedFrameMs() const { return FrameMsAvg; }
+    float GetSmoothedGameThreadMs() const { return GameThreadMsAvg; }
+
+private:
+    float Density = 1.f;
+    float LowestDensity = 1.f;
+    float FrameMsAvg = 0.f;
+    float GameThreadMsAvg = 0.f;
+    float SinceAdjustSec = 0.f;
+    int32 Adjustments = 0;
+    bool bHasSamples = false;
+};
@@ -0,0 +1,234 @@
+#include "HeadlessSim.h"
+#include "MainGameMode.h"
+#include "HAL/PlatformMisc.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+#include "../Enemies/EnemyActor.h"
+#include "../Enemies/EnemyRegistry.h"
+#include "../Enemies/EnemySimSubsystem.h"
+#include "../Player/AMainPawn.h"
+
+bool FHeadlessSimSettings::ParseCommandLine(FHeadlessSimSettings& Out)
+{
+    const TCHAR* Cmd = FCommandLine::Get();
+    if (!FParse::Param(Cmd, TEXT("TunnelzHeadless")))
+        return false;
+
+    FParse::Value(Cmd, TEXT("Runs="), Out.Runs);
+    FParse::Value(Cmd, TEXT("StepHz="), Out.StepHz);
+    FParse::Value(Cmd, TEXT("MaxRunSec="), Out.MaxRunSec);
+    FParse::Value(Cmd, TEXT("FrameBudgetMs="), Out.FrameBudgetMs);
+    FParse::Value(Cmd, TEXT("Seed="), Out.Seed);
+    FParse::Value(Cmd, TEXT("BotReaction="), Out.ReactionSec);
+    FParse::Value(Cmd, TEXT("BotMiss="), Out.MissChance);
+
+    Out.Runs = FMath::Max(Out.Runs, 1);
+    if (Out.StepHz > 0.f)
+        Out.StepHz = FMath::Clamp(Out.StepHz, 10.f, 1000.f);
+    Out.MaxRunSec = FMath::Max(Out.MaxRunSec, 1.f);
+    Out.FrameBudgetMs = FMath::Max(Out.FrameBudgetMs, 1.f);
+    return true;
+}
+
+FHeadlessSim::FHeadlessSim(const FHeadlessSimSettings& InSettings)
+    : Settings(InSettings)
+{
+    WallStart = FPlatformTime::Seconds();
+}
+
+void FHeadlessSim::Tick(AMainGameMode& GM)
+{
+    if (bFinished)
+        return;
+
+    AMainPawn* Pawn = Cast<AMainPawn>(UGameplayStatics::GetPlayerPawn(&GM, 0));
+    const float Dt = 1.f / Settings.StepHz;
+    const double Deadline = FPlatformTime::Seconds() + Settings.FrameBudgetMs * 1e-3;
+    do
+    {
+        if (!bInRun)
+        {
+            StartRun(GM);
+            Pawn = Cast<AMainPawn>(UGameplayStatics::GetPlayerPawn(&GM, 0)); // the first run may spawn it
+        }
+
+        Step(GM, Pawn, Dt);
+
+        if (!GM.IsPlaying())
+            EndRun(GM, false);
+        else if (GM.GetRunTime() >= Settings.MaxRunSec)
+            EndRun(GM, true);
+    }
+    while (!bFinished && FPlatformTime::Seconds() < Deadline);
+}
+
+void FHeadlessSim::StartRun(AMainGameMode& GM)
+{
+    if (Settings.Seed != 0)
+        GM.SetNextRunSeed(Settings.Seed + Results.Num());
+    GM.StartRun();
+
+    // The frame clock no longer moves anything the sim steps
+    if (UEnemySimSubsystem* Sim = GM.GetWorld()->GetSubsystem<UEnemySimSubsystem>())
+        Sim->SetManualStepping(true);
+    if (APawn* Pawn = UGameplayStatics::GetPlayerPawn(&GM, 0))
+        Pawn->SetActorTickEnabled(false);
+
+    BotRng.Initialize(GM.GetRunSeed() ^ 0xB07);
+    NextDecisionIn = 0.f;
+    FreezeCooldown = 0.f;
+    PeakEnemies = 0;
+    bInRun = true;
+}
+
+void FHeadlessSim::Step(AMainGameMode& GM, AMainPawn* Pawn, float Dt)
+{
+    GM.StepGameplay(Dt);
+    SystemSec[Spawning] += GM.LastAdvanceSec;
+    SystemSec[PawnLanes] += GM.LastPawnStepSec;
+
+    UWorld* World = GM.GetWorld();
+    if (const UEnemySimSubsystem* Sim = World->GetSubsystem<UEnemySimSubsystem>())
+    {
+        SystemSec[EnemyUpdate] += Sim->LastUpdateSec;
+        SystemSec[EnemyWriteback] += Sim->LastWritebackSec;
+        SystemSec[LaneIndex] += Sim->LastIndexSec;
+    }
+
+    if (Pawn && GM.IsPlaying())
+    {
+        const double Start = FPlatformTime::Seconds();
+        StepBot(GM, *Pawn, Dt);
+        SystemSec[Bot] += FPlatformTime::Seconds() - Start;
+    }
+
+    if (const UEnemyRegistry* Registry = World->GetSubsystem<UEnemyRegistry>())
+        PeakEnemies = FMath::Max(PeakEnemies, Registry->NumActive() + Registry->NumFrozen());
+
+    ++NumSteps;
+    SimulatedSec += Dt;
+}
+
+void FHeadlessSim::StepBot(AMainGameMode& GM, AMainPawn& Pawn, float Dt)
+{
+    FreezeCooldown -= Dt;
+    NextDecisionIn -= Dt;
+    if (NextDecisionIn > 0.f)
+        return;
+    NextDecisionIn = Settings.ReactionSec;
+    if (BotRng.GetFraction() < Settings.MissChance)
+        return;
+
+    // Cash in frozen enemies once a few have piled up
+    if (const UEnemyRegistry* Registry = GM.GetWorld()->GetSubsystem<UEnemyRegistry>())
+    {
+        if (Registry->NumFrozen() >= Settings.CollectAt)
+            Pawn.TryCollect();
+    }
+
+    const float X = Pawn.GetActorLocation().X;
+    const int32 Lane = Pawn.GetCurrentLane();
+    float Dist = 0.f;
+    AEnemyActor* Threat = GM.FindNearestThreatInLane(Lane, X, Dist);
+    if (!Threat || Dist > Settings.ThreatDistance)
+        return;
+
+    // Dodge into the lane whose nearest threat is furthest away, if it's clearly better
+    int32 BestLane = Lane;
+    float BestDist = Dist;
+    for (int32 Other = 0; Other < GM.GetLaneLayout().NumLanes; ++Other)
+    {
+        float OtherDist = 0.f;
+        if (Other == Lane)
+            continue;
+        if (!GM.FindNearestThreatInLane(Other, X, OtherDist))
+            OtherDist = TNumericLimits<float>::Max();
+        if (OtherDist > BestDist * 2.f)
+        {
+            BestLane = Other;
+            BestDist = OtherDist;
+        }
+    }
+    if (BestLane != Lane && Pawn.TryChangeLane(BestLane))
+        return;
+
+    if (FreezeCooldown <= 0.f)
+    {
+        Threat->Freeze();
+        FreezeCooldown = Settings.FreezeCooldownSec;
+    }
+}
+
+void FHeadlessSim::EndRun(AMainGameMode& GM, bool bTimedOut)
+{
+    if (bTimedOut)
+        GM.OnPlayerDied();
+
+    FRunResult& R = Results.AddDefaulted_GetRef();
+    R.Seed = GM.GetRunSeed();
+    R.Score = GM.GetScore();
+    R.TimeSec = GM.GetRunTime();
+    R.PeakEnemies = PeakEnemies;
+    R.bTimedOut = bTimedOut;
+    bInRun = false;
+
+    UE_LOG(LogTemp, Display, TEXT("Headless run %d/%d: seed %d, score %d, %.1f s%s, peak %d enemies"),
+        Results.Num(), Settings.Runs, R.Seed, R.Score, R.TimeSec, bTimedOut ? TEXT(" (timeout)") : TEXT(""), R.PeakEnemies);
+
+    if (Results.Num() < Settings.Runs)
+        return;
+
+    bFinished = true;
+    Report(*GLog);
+
+    const FString Path = FPaths::ProjectSavedDir() / TEXT("HeadlessSim") / FString::Printf(TEXT("Runs_%s.csv"), *FDateTime::Now().ToString());
+    if (WriteCsv(Path))
+        UE_LOG(LogTemp, Display, TEXT("Headless results written to %s"), *Path);
+
+    FPlatformMisc::RequestExit(false, TEXT("FHeadlessSim"));
+}
+
+void FHeadlessSim::Report(FOutputDevice& Ar) const
+{
+    static const TCHAR* SystemNames[NumSystems] =
+    {
+        TEXT("spawning (game mode)"), TEXT("enemy update"), TEXT("enemy writeback"), TEXT("lane index"), TEXT("pawn lanes"), TEXT("bot"),
+    };
+
+    const double WallSec = FPlatformTime::Seconds() - WallStart;
+    double SumScore = 0.0, SumTime = 0.0;
+    int32 MaxPeak = 0, NumTimedOut = 0;
+    for (const FRunResult& R : Results)
+    {
+        SumScore += R.Score;
+        SumTime += R.TimeSec;
+        MaxPeak = FMath::Max(MaxPeak, R.PeakEnemies);
+        NumTimedOut += R.bTimedOut ? 1 : 0;
+    }
+    const int32 N = FMath::Max(Results.Num(), 1);
+
+    Ar.Logf(TEXT("Headless sim: %d runs, %.1f simulated min in %.1f wall s (%.0fx real time), %lld steps at %.0f Hz"),
+        Results.Num(), SimulatedSec / 60.0, WallSec, WallSec > 0.0 ? SimulatedSec / WallSec : 0.0, NumSteps, Settings.StepHz);
+    Ar.Logf(TEXT("  mean score %.1f, mean survival %.1f s, %d timed out (%.0f s), peak %d enemies"),
+        SumScore / N, SumTime / N, NumTimedOut, Settings.MaxRunSec, MaxPeak);
+    Ar.Logf(TEXT("    %-22s %10s %10s"), TEXT("system"), TEXT("us/step"), TEXT("total s"));
+    for (int32 s = 0; s < NumSystems; ++s)
+    {
+        Ar.Logf(TEXT("    %-22s %10.2f %10.3f"), SystemNames[s], NumSteps > 0 ? SystemSec[s] * 1e6 / NumSteps : 0.0, SystemSec[s]);
+    }
+}
+
+bool FHeadlessSim::WriteCsv(const FString& Path) const
+{
+    FString Csv = TEXT("run,seed,score,time_s,peak_enemies,timed_out\n");
+    for (int32 i = 0; i < Results.Num(); ++i)
+    {
+        const FRunResult& R = Results[i];
+        Csv += FString::Printf(TEXT("%d,%d,%d,%.2f,%d,%d\n"), i, R.Seed, R.Score, R.TimeSec, R.PeakEnemies, R.bTimedOut ? 1 : 0);
+    }
+    return FFileHelper::SaveStringToFile(Csv, *Path);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+class AMainGameMode;
+class AMainPawn;
+
+// -------- Headless fast-forward simulation --------
+// Started with -TunnelzHeadless, normally alongside -game -nullrhi -nosound -unattended. The game mode
+// stops running off the frame clock. Instead, every engine frame steps the spawning, the enemy
+// simulation and the pawn's lane logic at a fixed timestep until the frame's wall-clock budget is spent,
+// with a bot playing. Runs restart back to back; each run's score, survival time and peak enemy count
+// are logged and written to Saved/HeadlessSim with the per-system step cost, then the process exits.
+struct FHeadlessSimSettings
+{
+    int32 Runs = 20;
+    float StepHz = 0.f;           // 0 = the game mode's GameplayStepHz
+    float MaxRunSec = 600.f;      // a run still alive after this ends as a timeout
+    float FrameBudgetMs = 100.f;  // wall time spent stepping per engine frame
+    int32 Seed = 0;               // run i uses Seed + i; 0 = the game mode's usual seed
+
+    // Bot
+    float ReactionSec = 0.15f;    // how often it decides
+    float MissChance = 0.1f;      // fraction of decisions it skips
+    float ThreatDistance = 400.f; // threats in its lane further than this are ignored
+    float FreezeCooldownSec = 0.5f;
+    int32 CollectAt = 3;          // frozen enemies it lets pile up before collecting
+
+    // True if -TunnelzHeadless is on the command line; the other -Key=Value flags override the defaults
+    static bool ParseCommandLine(FHeadlessSimSettings& Out);
+};
+
+class FHeadlessSim
+{
+public:
+    explicit FHeadlessSim(const FHeadlessSimSettings& InSettings);
+
+    // One engine frame's worth of fixed steps; requests exit after the last run
+    void Tick(AMainGameMode& GM);
+
+private:
+    struct FRunResult
+    {
+        int32 Seed = 0;
+        int32 Score = 0;
+        float TimeSec = 0.f;
+        int32 PeakEnemies = 0;
+        bool bTimedOut = false;
+    };
+
+    enum ESystem : uint8 { Spawning, EnemyUpdate, EnemyWriteback, LaneIndex, PawnLanes, Bot, NumSystems };
+
+    void StartRun(AMainGameMode& GM);
+    void Step(AMainGameMode& GM, AMainPawn* Pawn, float Dt);
+    void StepBot(AMainGameMode& GM, AMainPawn& Pawn, float Dt);
+    void EndRun(AMainGameMode& GM, bool bTimedOut);
+    void Report(FOutputDevice& Ar) const;
+    bool WriteCsv(const FString& Path) const;
+
+    FHeadlessSimSettings Settings;
+    TArray<FRunResult> Results;
+
+    bool bInRun = false;
+    bool bFinished = false;
+    int32 PeakEnemies = 0;
+
+    FRandomStream BotRng;
+    float NextDecisionIn = 0.f;
+    float FreezeCooldown = 0.f;
+
+    double SystemSec[NumSystems] = {};
+    int64 NumSteps = 0;
+    double SimulatedSec = 0.0;
+    double WallStart = 0.0;
+};
@@ -0,0 +1,82 @@
+#include "LevelAssetStreamer.h"
+#include "MainGameMode.h"
+#include "Engine/AssetManager.h"
+
+void FLevelAssetStreamer::Release(const TSharedPtr<FStreamableHandle>& Handle)
+{
+    if (!Handle.IsValid())
+        return;
+    if (Handle->IsLoadingInProgress())
+        Handle->CancelHandle();
+    else
+        Handle->ReleaseHandle();
+}
+
+void FLevelAssetStreamer::ReleaseAll()
+{
+    for (const TPair<int32, TSharedPtr<FStreamableHandle>>& Pair : Handles)
+        Release(Pair.Value);
+    Handles.Reset();
+}
+
+void FLevelAssetStreamer::Init(TConstArrayView<FLevelProgression> Levels, FOnLevelLoaded InOnLoaded)
+{
+    ReleaseAll();
+    OnLoaded = MoveTemp(InOnLoaded);
+
+    LevelPaths.Reset(Levels.Num());
+    for (const FLevelProgression& Level : Levels)
+    {
+        TArray<FSoftObjectPath>& Paths = LevelPaths.AddDefaulted_GetRef();
+        for (const FEnemyWeight& W : Level.EnemyWeights)
+        {
+            if (!W.Class.IsNull() && W.Weight > 0.f)
+                Paths.AddUnique(W.Class.ToSoftObjectPath());
+        }
+    }
+}
+
+void FLevelAssetStreamer::SetCurrentLevel(int32 Level)
+{
+    for (auto It = Handles.CreateIterator(); It; ++It)
+    {
+        if (It.Key() < Level || It.Key() > Level + 1)
+        {
+            Release(It.Value());
+            It.RemoveCurrent();
+        }
+    }
+
+    Request(Level);
+    Request(Level + 1);
+}
+
+void FLevelAssetStreamer::Request(int32 Level)
+{
+    if (!LevelPaths.IsValidIndex(Level) || Handles.Contains(Level))
+        return;
+
+    if (LevelPaths[Level].Num() == 0)
+    {
+        Handles.Add(Level, nullptr);
+        OnLoaded.ExecuteIfBound(Level);
+        return;
+    }
+
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(LevelPaths[Level],
+        FStreamableDelegate::CreateLambda([this, Level]() { OnLoaded.ExecuteIfBound(Level); }),
+        FStreamableManager::AsyncLoadHighPriority, true);
+    Handles.Add(Level, Handle);
+}
+
+double FLevelAssetStreamer::WaitForLevel(int32 Level)
+{
+    Request(Level);
+    const TSharedPtr<FStreamableHandle>* Handle = Handles.Find(Level);
+    if (!Handle || !Handle->IsValid() || (*Handle)->HasLoadCompleted())
+        return 0.0;
+
+    const double Start = FPlatformTime::Seconds();
+    (*Handle)->WaitUntilComplete();
+    return FPlatformTime::Seconds() - Start;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+
+struct FLevelProgression;
+
+// Keeps the enemy classes of the current and next level streamed in. Each level's classes load
+// asynchronously as one request through the asset manager's streamable manager; requests for levels
+// outside the window are released, so their classes can be collected once no pooled enemy uses them.
+class FLevelAssetStreamer
+{
+public:
+    DECLARE_DELEGATE_OneParam(FOnLevelLoaded, int32 /*Level*/);
+
+    ~FLevelAssetStreamer() { ReleaseAll(); }
+
+    void Init(TConstArrayView<FLevelProgression> Levels, FOnLevelLoaded InOnLoaded);
+
+    // Requests Level and Level + 1, releases the rest
+    void SetCurrentLevel(int32 Level);
+
+    // Blocks until the level's request completes (requesting it if needed); returns the seconds waited
+    double WaitForLevel(int32 Level);
+
+private:
+    void Request(int32 Level);
+    void ReleaseAll();
+
+    // Cancels a request still in flight (its callback never runs), otherwise lets its classes go
+    static void Release(const TSharedPtr<FStreamableHandle>& Handle);
+
+    TArray<TArray<FSoftObjectPath>> LevelPaths;
+    TMap<int32, TSharedPtr<FStreamableHandle>> Handles;
+    FOnLevelLoaded OnLoaded;
+};
@@ -1,34 +1,67 @@
 #include "MainGameMode.h"
 #include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "CoreGlobals.h"
+#include "Engine/StaticMesh.h"
 #include "GameFramework/PlayerStart.h"
 #include "GameFramework/PlayerController.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Guid.h"
+#include "RenderCore.h"
 
 #include "../Player/AMainPawn.h"
 #include "../Enemies/EnemyActor.h"
+#include "../Enemies/EnemyPool.h"
+#include "../Enemies/EnemyRegistry.h"
+#include "../Enemies/EnemySimSubsystem.h"
 #include "../SaveGame/HighScoreSaveGame.h"
 
 #define HIGH_SCORE_SAVE_SLOT_NAME TEXT("HighScore")
 
+namespace
+{
+    constexpr double SaveCoalesceSec = 1.0;
+}
+
+static TAutoConsoleVariable<int32> CVarRunSeed(
+    TEXT("Tunnelz.Run.Seed"),
+    0,
+    TEXT("Seed for the next runs' spawn schedule and spawn slots (0 = game mode RunSeed, or a new seed per run).\n")
+    TEXT("Read at StartRun; the seed in use is logged then and at game over."));
+
 void AMainGameMode::BeginPlay()
 {
     Super::BeginPlay();
     PrimaryActorTick.bCanEverTick = true;
     PrimaryActorTick.bStartWithTickEnabled = true;
+    BeginPlayTime = FPlatformTime::Seconds();
+    BootFrames = 0;
 
-    // High score saving
-    if (UGameplayStatics::DoesSaveGameExist(HIGH_SCORE_SAVE_SLOT_NAME, 0))
-    {
-        USaveGame* Loaded = UGameplayStatics::LoadGameFromSlot(HIGH_SCORE_SAVE_SLOT_NAME, 0);
-        SaveHighScoreSG = Cast<UHighScoreSaveGame>(Loaded);
-    }
+    // High score saving: start from an empty save and fill it in when the slot has loaded in the background
+    SaveHighScoreSG = Cast<UHighScoreSaveGame>(UGameplayStatics::CreateSaveGameObject(UHighScoreSaveGame::StaticClass()));
+    check(SaveHighScoreSG);
+    UGameplayStatics::AsyncLoadGameFromSlot(HIGH_SCORE_SAVE_SLOT_NAME, 0,
+        FAsyncLoadGameFromSlotDelegate::CreateUObject(this, &AMainGameMode::OnHighScoreLoaded));
+
+    EnemyPool = NewObject<UEnemyPool>(this);
+    EnemyRegistry = GetWorld()->GetSubsystem<UEnemyRegistry>();
+    check(EnemyRegistry);
 
-    if (!SaveHighScoreSG)
+    // Enemy classes of the first two levels stream in while the menu is up
+    PrewarmCounts.Reset();
+    for (const FLevelProgression& Level : Levels)
     {
-        SaveHighScoreSG = Cast<UHighScoreSaveGame>(UGameplayStatics::CreateSaveGameObject(UHighScoreSaveGame::StaticClass()));
+        for (const FEnemyWeight& W : Level.EnemyWeights)
+        {
+            if (W.Class.IsNull() || W.Weight <= 0.f)
+                continue;
+            int32& Count = PrewarmCounts.FindOrAdd(W.Class);
+            Count = FMath::Max(Count, Level.MaxNumActiveEnemies + EnemyPoolHeadroom);
+        }
     }
-
-    check(SaveHighScoreSG);
+    EnemyClassStreamer.Init(Levels, FLevelAssetStreamer::FOnLevelLoaded::CreateUObject(this, &AMainGameMode::OnLevelClassesLoaded));
+    EnemyClassStreamer.SetCurrentLevel(0);
     
     // Calculate spawn enemy aabb
     EnemySpawnAABB.Max.X = ArenaSize.X - SpawnOffsetFromArenaWall.X;
@@ -39,6 +72,25 @@ void AMainGameMode::BeginPlay()
     EnemySpawnAABB.Min.Y = -ArenaSize.Y / 2.f + SpawnOffsetFromArenaWall.Y;
     EnemySpawnAABB.Min.Z = -ArenaSize.Z / 2.f + SpawnOffsetFromArenaWall.Z;
 
+    FHeadlessSimSettings HeadlessSettings;
+    if (FHeadlessSimSettings::ParseCommandLine(HeadlessSettings))
+    {
+        if (HeadlessSettings.StepHz <= 0.f)
+            HeadlessSettings.StepHz = GameplayStepHz > 0.f ? GameplayStepHz : 60.f;
+        UE_LOG(LogTemp, Display, TEXT("Headless simulation: %d runs at %.0f Hz"), HeadlessSettings.Runs, HeadlessSettings.StepHz);
+        Headless = MakeUnique<FHeadlessSim>(HeadlessSettings);
+        return; // no UI; the first tick starts a run
+    }
+
+    if (GameplayStepHz > 0.f)
+    {
+        if (UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>())
+        {
+            Sim->SetManualStepping(true);
+            Sim->SetRenderInterpolation(true);
+        }
+    }
+
     if (!MenuWidget && MenuWidgetClass)
     {
         MenuWidget = CreateWidget<UUserWidget>(GetWorld(), MenuWidgetClass);
@@ -49,6 +101,12 @@ void AMainGameMode::BeginPlay()
         }
     }
 
+    // The HUD is built once the menu has been drawn (see Tick), or by StartRun if that comes first
+    ShowMenu(); // boot into menu
+}
+
+void AMainGameMode::CreateHUDWidget()
+{
     if (!HUDWidget && HUDWidgetClass)
     {
         HUDWidget = CreateWidget<UUserWidget>(GetWorld(), HUDWidgetClass);
@@ -58,8 +116,85 @@ void AMainGameMode::BeginPlay()
             HUDWidget->SetVisibility(ESlateVisibility::Hidden);
         }
     }
+}
 
-    ShowMenu(); // boot into menu
+void AMainGameMode::OnHighScoreLoaded(const FString& SlotName, const int32 UserIndex, USaveGame* Loaded)
+{
+    UHighScoreSaveGame* Saved = Cast<UHighScoreSaveGame>(Loaded);
+    UE_LOG(LogTemp, Log, TEXT("Cold start: high score save %s %.0f ms after BeginPlay"),
+        Saved ? TEXT("loaded") : TEXT("absent"), (FPlatformTime::Seconds() - BeginPlayTime) * 1e3);
+    if (!bSaveLoaded) // EndPlay may have loaded it already
+        MergeLoadedHighScore(Saved);
+}
+
+void AMainGameMode::MergeLoadedHighScore(UHighScoreSaveGame* Saved)
+{
+    bSaveLoaded = true;
+    if (!Saved)
+        return;
+
+    // Runs may already have ended while this was loading (their save waited for this); merge them in.
+    // The last one only beat the high score if it beat the saved one too.
+    if (SaveHighScoreSG)
+    {
+        if (SaveHighScoreSG->NumRuns > 0 && Phase == ERunPhase::GameOver)
+            bHasNewHighScore = Score > Saved->HighScore && Score >= SaveHighScoreSG->HighScore;
+        Saved->HighScore = FMath::Max(Saved->HighScore, SaveHighScoreSG->HighScore);
+        Saved->NumRuns += SaveHighScoreSG->NumRuns;
+    }
+    SaveHighScoreSG = Saved;
+}
+
+void AMainGameMode::RequestHighScoreSave()
+{
+    if (!bSavePending)
+        SaveDueTime = FPlatformTime::Seconds() + SaveCoalesceSec;
+    bSavePending = true;
+}
+
+void AMainGameMode::StartHighScoreSave()
+{
+    // Serializing is cheap and has to happen here; the slot write goes to a worker
+    TArray<uint8> Data;
+    bSavePending = false;
+    if (!UGameplayStatics::SaveGameToMemory(SaveHighScoreSG, Data))
+        return;
+
+    SaveTask = UE::Tasks::Launch(TEXT("HighScoreSave"), [Data = MoveTemp(Data)]()
+    {
+        return UGameplayStatics::SaveDataToSlot(Data, HIGH_SCORE_SAVE_SLOT_NAME, 0);
+    });
+}
+
+void AMainGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // One writer per slot: let the write in flight finish before anything else touches it
+    if (SaveTask.IsValid())
+        SaveTask.Wait();
+
+    // Quitting within the coalescing window (or before the slot had loaded): write it now.
+    // The history file's destructor flushes its own appends.
+    if (bSavePending && SaveHighScoreSG)
+    {
+        if (!bSaveLoaded)
+            MergeLoadedHighScore(Cast<UHighScoreSaveGame>(UGameplayStatics::LoadGameFromSlot(HIGH_SCORE_SAVE_SLOT_NAME, 0)));
+        UGameplayStatics::SaveGameToSlot(SaveHighScoreSG, HIGH_SCORE_SAVE_SLOT_NAME, 0);
+    }
+    bSavePending = false;
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AMainGameMode::OnLevelClassesLoaded(int32 Level)
+{
+    // Pool enemies of the new classes before their first spawn, spread over the next frames (see Tick);
+    // headless runs have no frames to hitch
+    if (Phase != ERunPhase::Playing)
+        return;
+    if (Headless)
+        PrewarmLevel(Level, MAX_int32);
+    else
+        PendingPrewarmLevels.AddUnique(Level);
 }
 
 void AMainGameMode::ShowMenu()
@@ -88,17 +223,55 @@ void AMainGameMode::StartRun()
         MenuWidget->SetVisibility(ESlateVisibility::Hidden);
     }
 
+    CreateHUDWidget();
     if (HUDWidget)
     {
         HUDWidget->SetVisibility(ESlateVisibility::Visible);
     }
 
+    RunStartTime = FPlatformTime::Seconds();
+    bFirstSpawnPending = true;
+
     // unpause, game input on
     UGameplayStatics::SetGlobalTimeDilation(GetWorld(), 1.f);
     SetInputUI(false);
 
     // reset world & (re)spawn player
     SoftResetWorld();
+    StepAccumulator = 0.f;
+    NumCappedFrames = 0;
+    FrameGovernor.Reset();
+    SpawnCredit = 0.f;
+    ApplySpawnDensity();
+    if (UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>())
+        Sim->ResetSignificanceStats();
+    if (AMainPawn* Pawn = Cast<AMainPawn>(UGameplayStatics::GetPlayerPawn(this, 0)))
+        Pawn->SetFixedStepDriven(GameplayStepHz > 0.f && !Headless);
+
+    // Everything random about the run's spawns comes from this one seed
+    CurrentRunSeed = ChooseRunSeed();
+    NextRunSeed = 0;
+    SpawnSchedule.Compile(Levels);
+    SpawnSchedule.Start(CurrentRunSeed);
+    SpawnTimeline.Reset();
+    SpawnTimelineCursor = 0;
+    if (PrecomputedTimelineSec > 0.f)
+        SpawnSchedule.Precompute(PrecomputedTimelineSec, SpawnTimeline);
+    bHasPendingSpawn = NextSpawnEvent(PendingSpawn);
+    UE_LOG(LogTemp, Log, TEXT("Run seed %d (%d spawn events precomputed)"), CurrentRunSeed, SpawnTimeline.Num());
+
+    // The first two levels' classes were requested at boot; this only waits if the menu was very short
+    EnemyClassStreamer.SetCurrentLevel(0);
+    RunClassWaitSec = EnemyClassStreamer.WaitForLevel(0) + EnemyClassStreamer.WaitForLevel(1);
+
+    // Spawn enemies up front so the run itself only recycles them
+    const double PrewarmStart = FPlatformTime::Seconds();
+    EnemyPool->ResetCounters();
+    PendingPrewarmLevels.Reset();
+    PrewarmEnemyPool();
+    BuildSpawnSlots();
+    SpawnStats = FEnemySpawnStats();
+    RunPrewarmSec = FPlatformTime::Seconds() - PrewarmStart;
 
     Phase = ERunPhase::Playing;
 }
@@ -107,34 +280,55 @@ void AMainGameMode::OnPlayerDied()
 {
     Phase = ERunPhase::GameOver;
 
+    if (Headless)
+        return; // the headless sim reports the run and starts the next one
+
     ShowMenu();
 
-    // Save high score if needed
-    if (SaveHighScoreSG && Score > SaveHighScoreSG->HighScore)
+    if (EnemyPool)
+        EnemyPool->LogStats(*GLog, TEXT("run"));
+    LogSpawnStats(*GLog);
+    if (const UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>())
+        Sim->LogSignificanceStats(*GLog);
+    if (NumCappedFrames > 0)
+        UE_LOG(LogTemp, Log, TEXT("Gameplay steps capped on %d frames (MaxGameplayStepsPerFrame %d)"), NumCappedFrames, MaxGameplayStepsPerFrame);
+    if (FrameGovernor.NumAdjustments() > 0)
+        UE_LOG(LogTemp, Log, TEXT("Frame budget: %d density changes, lowest %.2f, ended at %.2f"),
+            FrameGovernor.NumAdjustments(), FrameGovernor.GetLowestDensity(), FrameGovernor.GetDensity());
+
+    // Nothing is written here: the run goes to the history file on a background pipe, and the
+    // high score save follows a moment later (see Tick), off the frame the menu appears on
+    FRunRecord Record;
+    Record.Score = Score;
+    Record.DurationSec = RunTime;
+    Record.Seed = CurrentRunSeed;
+    Record.Level = uint16(CurLevel);
+    RunHistory.Append(Record);
+
+    if (SaveHighScoreSG)
     {
-        SaveHighScoreSG->HighScore = Score;
-        UGameplayStatics::SaveGameToSlot(SaveHighScoreSG, HIGH_SCORE_SAVE_SLOT_NAME, 0);
-        bHasNewHighScore = true;
+        ++SaveHighScoreSG->NumRuns;
+        // Before the slot has loaded this is only known to beat earlier runs; MergeLoadedHighScore decides
+        if (Score > SaveHighScoreSG->HighScore)
+        {
+            SaveHighScoreSG->HighScore = Score;
+            bHasNewHighScore = bSaveLoaded;
+        }
+        RequestHighScoreSave();
     }
 }
 
 void AMainGameMode::SoftResetWorld()
 {
     // 1) Clear enemies / pickups (use tags or an interface in your project)
-    TArray<AActor*> ToKill;
-    UGameplayStatics::GetAllActorsWithTag(GetWorld(), FName("Enemy"), ToKill);
-    for (AActor* A : ToKill) { if (IsValid(A)) A->Destroy(); }
+    ReleaseEnemies(EnemyRegistry->GetActive());
+    ReleaseEnemies(EnemyRegistry->GetFrozen());
 
     // 2) Reset GM states
     CurLevel = 0;
-    NumAliveEnemies = 0;
+    RunTime = 0.f;
     Score = 0;
     bHasNewHighScore = false;
-    if (Levels.Num() > 0)
-    {
-        NextLevelTimer = Levels[0].DurationSec;
-        SpawnTimer = Levels[0].SpawnRateSec;
-    }
 
     // 3) Respawn or reset the player
     APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0);
@@ -175,100 +369,355 @@ void AMainGameMode::SetInputUI(bool bUI)
     }
 }
 
-TSubclassOf<AEnemyActor> AMainGameMode::PickEnemyFromWeights() const
+int32 AMainGameMode::ChooseRunSeed() const
 {
-    check(Levels.Num() > 0);
+    int32 Seed = NextRunSeed;
+    if (Seed == 0)
+        Seed = CVarRunSeed.GetValueOnGameThread();
+    if (Seed == 0)
+        FParse::Value(FCommandLine::Get(), TEXT("RunSeed="), Seed);
+    if (Seed == 0)
+        Seed = RunSeed;
+    if (Seed == 0)
+        Seed = FMath::Max(int32(FGuid::NewGuid().A & 0x7fffffff), 1);
+    return Seed;
+}
 
-    double total = 0.0;
-    for (const auto& KV : Levels[CurLevel].EnemyWeights)
+bool AMainGameMode::NextSpawnEvent(FSpawnEvent& Out)
+{
+    if (SpawnTimelineCursor < SpawnTimeline.Num())
     {
-        if (KV.Weight > 0.f)
-            total += KV.Weight;
+        Out = SpawnTimeline[SpawnTimelineCursor++];
+        return true;
     }
-    if (total <= 0.0) 
-        return nullptr;
+    return SpawnSchedule.Next(Out);
+}
 
-    // Weighted random pick
-    const double r = FMath::FRand() * total;
-    double acc = 0.0;
-    for (const auto& KV : Levels[CurLevel].EnemyWeights)
+void AMainGameMode::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (Headless)
     {
-        const float w = KV.Weight > 0.f ? KV.Weight : 0.f;
-        acc += w;
-        if (r <= acc)
-            return KV.Class;
+        Headless->Tick(*this);
+        return;
     }
-    return nullptr;
+
+    if (SaveTask.IsValid() && SaveTask.IsCompleted())
+    {
+        if (!SaveTask.GetResult())
+            UE_LOG(LogTemp, Warning, TEXT("High score save to slot %s failed"), HIGH_SCORE_SAVE_SLOT_NAME);
+        SaveTask = {};
+    }
+    if (bSavePending && !SaveTask.IsValid() && bSaveLoaded && SaveHighScoreSG && FPlatformTime::Seconds() >= SaveDueTime)
+        StartHighScoreSave();
+
+    // Frame 1 drew the boot menu; build the HUD now that it's up
+    if (BootFrames >= 0 && ++BootFrames == 2)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Cold start: engine init -> menu visible %.0f ms (BeginPlay -> menu %.0f ms)"),
+            (FPlatformTime::Seconds() - GStartTime) * 1e3, (FPlatformTime::Seconds() - BeginPlayTime) * 1e3);
+        BootFrames = -1;
+        CreateHUDWidget();
+    }
+
+    if (ERunPhase::Playing == Phase)
+        PrewarmPendingLevels();
+
+    if (GameplayStepHz <= 0.f)
+    {
+        AdvanceGameplay(DeltaTime);
+    }
+    else
+    {
+        const float StepSec = 1.f / GameplayStepHz;
+        StepAccumulator += DeltaTime;
+        int32 NumSteps = 0;
+        while (StepAccumulator >= StepSec && NumSteps < MaxGameplayStepsPerFrame)
+        {
+            StepGameplay(StepSec);
+            StepAccumulator -= StepSec;
+            ++NumSteps;
+        }
+        if (StepAccumulator >= StepSec)
+        {
+            StepAccumulator = FMath::Fmod(StepAccumulator, StepSec);
+            ++NumCappedFrames;
+        }
+
+        // Draw everything between the last two steps
+        const float Alpha = StepAccumulator / StepSec;
+        if (UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>())
+            Sim->Interpolate(Alpha);
+        if (AMainPawn* Pawn = Cast<AMainPawn>(UGameplayStatics::GetPlayerPawn(this, 0)))
+            Pawn->InterpolateRender(Alpha);
+    }
+
+    if (ERunPhase::Playing != Phase || Levels.Num() == 0)
+        return;
+
+    UpdateFrameBudget(DeltaTime);
+
+    const float NextLevelIn = CurLevel < Levels.Num() - 1 ? SpawnSchedule.GetLevelEnd(CurLevel) - RunTime : 0.f;
+    GEngine->AddOnScreenDebugMessage(uint64(uintptr_t(this)), 9999.0f, FColor::Yellow, 
+        FString::Printf(TEXT("Level: %d | Spawn T.: %.1f | Next Level T.: %.1f | Seed: %d"), CurLevel,
+            bHasPendingSpawn ? PendingSpawn.Time - RunTime : 0.f, NextLevelIn, CurrentRunSeed));
 }
 
-void AMainGameMode::Tick(float DeltaTime)
+void AMainGameMode::StepGameplay(float StepSec)
 {
-    Super::Tick(DeltaTime);
+    // Frame order: game mode, pawn, then the enemy tickable
+    double StartTime = FPlatformTime::Seconds();
+    AdvanceGameplay(StepSec);
+    LastAdvanceSec = FPlatformTime::Seconds() - StartTime;
+
+    StartTime = FPlatformTime::Seconds();
+    if (AMainPawn* Pawn = Cast<AMainPawn>(UGameplayStatics::GetPlayerPawn(this, 0)))
+        Pawn->AdvanceTimers(StepSec);
+    LastPawnStepSec = FPlatformTime::Seconds() - StartTime;
+
+    if (UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>())
+        Sim->Step(StepSec);
+}
 
+void AMainGameMode::AdvanceGameplay(float DeltaTime)
+{
     if (ERunPhase::Playing != Phase)
         return;
 
     if (Levels.Num() == 0)
         return;
 
-    // Check if we're going to the next level
-    if (NextLevelTimer <= 0.f && CurLevel < Levels.Num() - 1)
+    RunTime += DeltaTime;
+    const int32 PrevLevel = CurLevel;
+    while (CurLevel < Levels.Num() - 1 && RunTime >= SpawnSchedule.GetLevelEnd(CurLevel))
+        ++CurLevel;
+    if (CurLevel != PrevLevel)
+        EnemyClassStreamer.SetCurrentLevel(CurLevel);
+
+    if (!bHasPendingSpawn || PendingSpawn.Time > RunTime)
+        return;
+
+    // Every event that came due fires, so a long frame delays spawns instead of dropping them
+    RefreshSpawnSlots();
+    const float Density = FrameGovernor.GetDensity();
+    while (bHasPendingSpawn && PendingSpawn.Time <= RunTime)
     {
-        CurLevel += 1;
-        NextLevelTimer = Levels[CurLevel].DurationSec;
-        SpawnTimer = Levels[CurLevel].SpawnRateSec;
+        // Thinning skips events without touching the schedule, so the seed still decides what comes when
+        SpawnCredit += Density;
+        const bool bKeep = SpawnCredit >= 1.f;
+        if (bKeep)
+            SpawnCredit -= 1.f;
+        else if (!PendingSpawn.Class.IsNull())
+            ++SpawnStats.Thinned;
+
+        // A level capped at 0 still spawns nothing; any other keeps at least one enemy
+        const int32 Cap = Levels[PendingSpawn.Level].MaxNumActiveEnemies;
+        const int32 MaxActive = Cap > 0 ? FMath::Max(FMath::RoundToInt(Cap * Density), 1) : 0;
+        if (bKeep && !PendingSpawn.Class.IsNull() && EnemyRegistry->NumActive() < MaxActive)
+            SpawnEnemy(PendingSpawn.Class);
+        bHasPendingSpawn = NextSpawnEvent(PendingSpawn);
     }
+}
 
-    GEngine->AddOnScreenDebugMessage(uint64(uintptr_t(this)), 9999.0f, FColor::Yellow, 
-        FString::Printf(TEXT("Level: %d | Spawn T.: %.1f | Next Level T.: %.1f"), CurLevel, SpawnTimer, NextLevelTimer));
-    
-    NextLevelTimer -= DeltaTime;
-    SpawnTimer -= DeltaTime;
+void AMainGameMode::UpdateFrameBudget(float DeltaTime)
+{
+    if (!FrameBudget.bEnabled)
+        return;
+
+    // Wall-clock frame time, not the dilated DeltaTime
+    const float RealDelta = float(FApp::GetDeltaTime());
+    const float GameThreadMs = float(FPlatformTime::ToMilliseconds(GGameThreadTime));
+    const float OldDensity = FrameGovernor.GetDensity();
+    if (!FrameGovernor.Update(FrameBudget, RealDelta, RealDelta * 1e3f, GameThreadMs))
+        return;
+
+    UE_LOG(LogTemp, Log, TEXT("Frame budget: spawn density %.2f -> %.2f (frame %.1f ms, game thread %.1f ms, target %.1f ms) at %.1f s, level %d"),
+        OldDensity, FrameGovernor.GetDensity(), FrameGovernor.GetSmoothedFrameMs(), FrameGovernor.GetSmoothedGameThreadMs(),
+        FrameBudget.TargetMs, RunTime, CurLevel);
+    ApplySpawnDensity();
+}
+
+void AMainGameMode::ApplySpawnDensity()
+{
+    UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>();
+    if (!Sim)
+        return;
+
+    const float Density = FrameGovernor.GetDensity();
+    Sim->SetSpinScale(Density < FrameBudget.SpinOffBelowDensity ? 0.f : 1.f);
+    Sim->SetFrozenDithering(Density >= FrameBudget.FrozenDitherOffBelowDensity);
+}
 
-    if (SpawnTimer <= 0.f)
+void AMainGameMode::RefreshSpawnSlots()
+{
+    // Occupancy from where enemies were at the end of the last sim tick; slots acquired after this
+    // stay taken, so several spawns in one frame still land apart
+    SpawnSlots.BeginUpdate();
+    if (const UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>())
+    {
+        Sim->GetLaneIndex().ForEachFrom(SpawnSlots.GetVolume().Min.X - SpawnSlots.GetSpacing(),
+            [this](const FEnemyLaneIndex::FEntry& E) { SpawnSlots.Occupy(FVector(E.X, E.Y, E.Z)); });
+    }
+    SpawnSlots.EndUpdate();
+}
+
+void AMainGameMode::SpawnEnemy(const TSoftClassPtr<AEnemyActor>& EnemyClass)
+{
+    ++SpawnStats.Attempts;
+    FVector SpawnPoint;
+    if (!SpawnSlots.Acquire(SpawnPoint))
     {
-        SpawnTimer = Levels[CurLevel].SpawnRateSec;
+        ++SpawnStats.NoFreeSlot;
+        return;
+    }
 
-        if (NumAliveEnemies < Levels[CurLevel].MaxNumActiveEnemies)
+    // Streamed a level ahead, so normally loaded; a late class still spawns, just with a hitch
+    TSubclassOf<AEnemyActor> Class = EnemyClass.Get();
+    if (!Class)
+    {
+        ++SpawnStats.SyncLoads;
+        UE_LOG(LogTemp, Warning, TEXT("Enemy class %s wasn't streamed in yet, loading it synchronously"), *EnemyClass.ToString());
+        Class = EnemyClass.LoadSynchronous();
+    }
+
+    const double AcquireStart = FPlatformTime::Seconds();
+    if (EnemyPool->Acquire(GetWorld(), Class, SpawnPoint, FRotator::ZeroRotator))
+    {
+        ++SpawnStats.Spawned;
+        if (bFirstSpawnPending)
         {
-            TSubclassOf<AEnemyActor> enemyClass = PickEnemyFromWeights();
-            if (enemyClass)
+            bFirstSpawnPending = false;
+            UE_LOG(LogTemp, Log, TEXT("Cold start: StartRun -> first spawn %.0f ms, %.2f s of play (class wait %.1f ms, prewarm %.1f ms, spawn %.2f ms)"),
+                (FPlatformTime::Seconds() - RunStartTime) * 1e3, RunTime, RunClassWaitSec * 1e3, RunPrewarmSec * 1e3,
+                (FPlatformTime::Seconds() - AcquireStart) * 1e3);
+        }
+    }
+    else
+    {
+        ++SpawnStats.Blocked;
+    }
+}
+
+void AMainGameMode::BuildSpawnSlots()
+{
+    float Spacing = SpawnSlotSpacing;
+    if (Spacing <= 0.f)
+    {
+        // Far enough apart that two of the largest enemies can't touch
+        // Only the first two levels are sure to be loaded here; counting whatever else happens to be
+        // resident would make the slot layout, and so the run, depend on load timing
+        float MaxRadius = 0.f;
+        for (int32 LevelIdx = 0; LevelIdx < FMath::Min(Levels.Num(), 2); ++LevelIdx)
+        {
+            for (const FEnemyWeight& W : Levels[LevelIdx].EnemyWeights)
             {
-                int const maxTries = 16;
-                for (int i = 0; i < maxTries; i++)
+                const UClass* Class = W.Class.Get();
+                const AEnemyActor* CDO = Class ? Class->GetDefaultObject<AEnemyActor>() : nullptr;
+                if (CDO && CDO->MeshComponent && CDO->MeshComponent->GetStaticMesh())
                 {
-                    FVector RandomPoint = UKismetMathLibrary::RandomPointInBoundingBox_Box(EnemySpawnAABB);
-                    if (GetWorld()->SpawnActor<AEnemyActor>(enemyClass, RandomPoint, FRotator::ZeroRotator))
-                    {
-                        NumAliveEnemies++;
-                        break;
-                    }
+                    const float Radius = CDO->MeshComponent->GetStaticMesh()->GetBounds().SphereRadius * CDO->MeshComponent->GetRelativeScale3D().GetMax();
+                    MaxRadius = FMath::Max(MaxRadius, Radius);
                 }
             }
         }
+        Spacing = MaxRadius > 0.f ? 2.f * MaxRadius : 100.f;
     }
+
+    SpawnSlots.Build(EnemySpawnAABB, Spacing, CurrentRunSeed ^ 0x5107);
+    UE_LOG(LogTemp, Log, TEXT("Spawn slots: %d, %.0f apart"), SpawnSlots.NumSlots(), SpawnSlots.GetSpacing());
 }
 
-void AMainGameMode::OnActiveEnemyDestroyed(AActor* const EnemyActor)
+void AMainGameMode::LogSpawnStats(FOutputDevice& Ar) const
 {
-    if (EnemyActor->ActorHasTag("Frozen"))
-        return;
-
-    NumAliveEnemies -= 1;
-    check(NumAliveEnemies >= 0);
+    Ar.Logf(TEXT("Enemy spawns (seed %d): %d attempts, %d spawned, %d skipped (no free slot), %d blocked, %d sync class loads, %d thinned | %d slots"),
+        CurrentRunSeed, SpawnStats.Attempts, SpawnStats.Spawned, SpawnStats.NoFreeSlot, SpawnStats.Blocked, SpawnStats.SyncLoads, SpawnStats.Thinned, SpawnSlots.NumSlots());
 }
 
 void AMainGameMode::CollectFrozenEnemies()
 {
-    TArray<AActor*> FrozenEnemyActors;
-    UGameplayStatics::GetAllActorsWithTag(GetWorld(), FName("Frozen"), FrozenEnemyActors);
+    const int32 NumCollected = EnemyRegistry->NumFrozen();
+    ReleaseEnemies(EnemyRegistry->GetFrozen());
+
+    Score += NumCollected;
+}
+
+void AMainGameMode::ReleaseEnemy(AEnemyActor* Enemy)
+{
+    if (EnemyPool)
+        EnemyPool->Release(Enemy);
+    else if (IsValid(Enemy))
+        Enemy->Destroy();
+}
+
+void AMainGameMode::ReleaseEnemies(TConstArrayView<TObjectPtr<AEnemyActor>> Enemies)
+{
+    // Releasing removes each enemy from the set being walked, so go through a copy
+    TArray<AEnemyActor*, TInlineAllocator<64>> ToRelease;
+    for (AEnemyActor* Enemy : Enemies)
+        ToRelease.Add(Enemy);
+    for (AEnemyActor* Enemy : ToRelease)
+        ReleaseEnemy(Enemy);
+}
 
-    for (AActor* Actor : FrozenEnemyActors)
+void AMainGameMode::PrewarmEnemyPool()
+{
+    // Classes that are loaded; later levels' classes are pooled as they stream in
+    for (const TPair<TSoftClassPtr<AEnemyActor>, int32>& Pair : PrewarmCounts)
     {
-        Actor->Destroy();
+        if (UClass* Class = Pair.Key.Get())
+            EnemyPool->Prewarm(GetWorld(), Class, Pair.Value);
     }
+}
+
+int32 AMainGameMode::PrewarmLevel(int32 Level, int32 MaxSpawns)
+{
+    if (!Levels.IsValidIndex(Level))
+        return 0;
+
+    int32 NumSpawned = 0;
+    for (const FEnemyWeight& W : Levels[Level].EnemyWeights)
+    {
+        const int32* Count = PrewarmCounts.Find(W.Class);
+        if (UClass* Class = W.Class.Get(); Class && Count && NumSpawned < MaxSpawns)
+            NumSpawned += EnemyPool->Prewarm(GetWorld(), Class, *Count, MaxSpawns - NumSpawned);
+    }
+    return NumSpawned;
+}
+
+void AMainGameMode::PrewarmPendingLevels()
+{
+    // Each spawn runs BeginPlay and makes a dynamic material; a level's worth at once is a visible hitch
+    const bool bOverBudget = FrameBudget.bEnabled && FrameGovernor.GetSmoothedGameThreadMs() > FrameBudget.TargetMs;
+    int32 Budget = bOverBudget ? 1 : FMath::Max(EnemyPrewarmPerFrame, 1);
+    while (Budget > 0 && PendingPrewarmLevels.Num() > 0)
+    {
+        const int32 NumSpawned = PrewarmLevel(PendingPrewarmLevels[0], Budget);
+        if (NumSpawned < Budget)
+            PendingPrewarmLevels.RemoveAt(0); // pooled up to its counts
+        Budget -= NumSpawned;
+    }
+}
+
+FLaneLayout AMainGameMode::GetLaneLayout() const
+{
+    FLaneLayout Layout;
+    Layout.NumLanes = FMath::Max(NumLanes, 1);
+    Layout.LaneWidth = LaneWidth > 0.f ? LaneWidth : ArenaSize.Y / Layout.NumLanes;
+    return Layout;
+}
+
+AEnemyActor* AMainGameMode::FindNearestThreatInLane(int32 Lane, float FromX, float& Distance) const
+{
+    Distance = 0.f;
+    const UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>();
+    if (!Sim)
+        return nullptr;
 
-    Score += FrozenEnemyActors.Num();
+    double Dist = 0.0;
+    AEnemyActor* Threat = Sim->GetLaneIndex().FindNearestThreat(Lane, FromX, &Dist);
+    Distance = float(Dist);
+    return Threat;
 }
 
 int AMainGameMode::GetHighScore() const
@@ -3,10 +3,21 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "GameFramework/GameModeBase.h"
+#include "Tasks/Task.h"
+#include "../Enemies/EnemySimSubsystem.h"
+#include "../SaveGame/RunHistory.h"
+#include "FrameBudgetGovernor.h"
+#include "HeadlessSim.h"
+#include "LevelAssetStreamer.h"
+#include "SpawnSchedule.h"
+#include "SpawnSlotAllocator.h"
 #include "MainGameMode.generated.h"
 
 class AEnemyActor;
+class UEnemyPool;
+class UEnemyRegistry;
 class UHighScoreSaveGame;
+class USaveGame;
 
 UENUM(BlueprintType)
 enum class ERunPhase : uint8 { Menu, Playing, GameOver };
@@ -15,7 +26,8 @@ USTRUCT(BlueprintType)
 struct FEnemyWeight 
 {
     GENERATED_BODY()
-    UPROPERTY(EditAnywhere, BlueprintReadWrite) TSubclassOf<AEnemyActor> Class;
+    // Soft: loaded in the background for the current and next level (FLevelAssetStreamer)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite) TSoftClassPtr<AEnemyActor> Class;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0")) float Weight = 1.f;
 };
 
@@ -36,11 +48,28 @@ struct FLevelProgression
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level", meta = (ClampMin = "0.05"))
     float SpawnRateSec = 1.0f;
 
+    // Each interval varies by up to +-this fraction of SpawnRateSec, drawn from the run seed
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level", meta = (ClampMin = "0.0", ClampMax = "0.95"))
+    float SpawnJitter = 0.f;
+
     // Cap on concurrent enemies
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level", meta = (ClampMin = "0"))
     int32 MaxNumActiveEnemies = 5;
 };
 
+// Spawn bookkeeping for the current run. Every attempt is a single pool Acquire at a free slot.
+USTRUCT(BlueprintType)
+struct FEnemySpawnStats
+{
+    GENERATED_BODY()
+    UPROPERTY(BlueprintReadOnly) int32 Attempts = 0;
+    UPROPERTY(BlueprintReadOnly) int32 Spawned = 0;
+    UPROPERTY(BlueprintReadOnly) int32 NoFreeSlot = 0; // volume full; the spawn is skipped
+    UPROPERTY(BlueprintReadOnly) int32 Blocked = 0;    // slot free of enemies but the class' spawn collision check failed
+    UPROPERTY(BlueprintReadOnly) int32 SyncLoads = 0;  // class still streaming when it was due; loaded on the spot (hitch)
+    UPROPERTY(BlueprintReadOnly) int32 Thinned = 0;    // dropped to hold the frame budget (spawn density below 1)
+};
+
 UCLASS()
 class TUNNELZ_API AMainGameMode : public AGameModeBase
 {
@@ -60,6 +89,14 @@ public:
 
     virtual void Tick(float DeltaTime) override;
 
+    // One fixed gameplay step: game mode, pawn, then the enemy simulation. The fixed-step loop and the
+    // headless sim both run it; the enemy simulation times its own phases (UEnemySimSubsystem::LastUpdateSec)
+    void StepGameplay(float StepSec);
+
+    // Wall time of the last StepGameplay's game mode (spawning) and pawn parts, for profiling
+    double LastAdvanceSec = 0.0;
+    double LastPawnStepSec = 0.0;
+
     UFUNCTION(BlueprintCallable) bool IsPlaying() const 
     { 
         return Phase == ERunPhase::Playing;
@@ -77,15 +114,63 @@ public:
         return bHasNewHighScore;
     }
 
-    void OnActiveEnemyDestroyed(AActor* const EnemyActor);
+    // Takes an enemy out of play (back to the pool); the registry's active/frozen sets update with it
+    void ReleaseEnemy(AEnemyActor* Enemy);
+    void ReleaseEnemies(TConstArrayView<TObjectPtr<AEnemyActor>> Enemies);
+
+    UEnemyPool* GetEnemyPool() const { return EnemyPool; }
+
+    FLaneLayout GetLaneLayout() const;
+
+    UFUNCTION(BlueprintPure, Category = "Enemies") FEnemySpawnStats GetSpawnStats() const { return SpawnStats; }
+
+    // Seed of the current (or last) run; replaying it gives the same spawn times, classes and slots
+    UFUNCTION(BlueprintPure, Category = "Level Progression") int32 GetRunSeed() const { return CurrentRunSeed; }
+
+    // Used by the next StartRun only, ahead of every other seed source
+    void SetNextRunSeed(int32 Seed) { NextRunSeed = Seed; }
+
+    // Seconds of play in the current (or last) run
+    UFUNCTION(BlueprintPure, Category = "Level Progression") float GetRunTime() const { return RunTime; }
+
+    // Fraction of each level's enemy cap and spawn rate in use; below 1 while the frame budget governor sheds load
+    UFUNCTION(BlueprintPure, Category = "Performance") float GetSpawnDensity() const { return FrameGovernor.GetDensity(); }
+
+    // Appended to at every game over (not in headless runs)
+    FRunHistoryFile& GetRunHistory() { return RunHistory; }
+
+    void LogSpawnStats(FOutputDevice& Ar) const;
+
+    UFUNCTION(BlueprintPure, Category = "Arena") float GetLaneCenterY(int32 Lane) const { return GetLaneLayout().GetCenterY(Lane); }
+
+    // Closest active enemy ahead of FromX in the lane, from the enemy lane index (no physics query)
+    UFUNCTION(BlueprintCallable, Category = "Arena")
+    AEnemyActor* FindNearestThreatInLane(int32 Lane, float FromX, float& Distance) const;
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
     void SoftResetWorld();
     void SetInputUI(bool bUI);
-    TSubclassOf<AEnemyActor> PickEnemyFromWeights() const;
+    int32 ChooseRunSeed() const;
+    bool NextSpawnEvent(FSpawnEvent& Out);
+    void PrewarmEnemyPool();
+    int32 PrewarmLevel(int32 Level, int32 MaxSpawns);
+    void PrewarmPendingLevels();
+    void OnLevelClassesLoaded(int32 Level);
+    void OnHighScoreLoaded(const FString& SlotName, const int32 UserIndex, USaveGame* Loaded);
+    void MergeLoadedHighScore(UHighScoreSaveGame* Saved);
+    void RequestHighScoreSave();
+    void StartHighScoreSave();
+    void CreateHUDWidget();
+    void BuildSpawnSlots();
+    void AdvanceGameplay(float DeltaTime); // level progression and spawning; one step, or one frame without fixed steps
+    void RefreshSpawnSlots();
+    void SpawnEnemy(const TSoftClassPtr<AEnemyActor>& EnemyClass);
+    void UpdateFrameBudget(float DeltaTime);
+    void ApplySpawnDensity();
 
 public:
     UPROPERTY() UUserWidget* MenuWidget = nullptr;
@@ -100,19 +185,112 @@ public:
     UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Arena")
     FVector SpawnOffsetFromArenaWall = FVector(1.f, 1.f, 1.f);
 
+    // Lanes the player switches between, spread evenly across the arena's width
+    UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Arena", meta = (ClampMin = "1"))
+    int32 NumLanes = 2;
+
+    // 0 = ArenaSize.Y / NumLanes
+    UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Arena", meta = (ClampMin = "0.0"))
+    float LaneWidth = 0.f;
+
+    // Sweep: enemies sweep and hits come from physics (Blueprint hit/overlap handling applies).
+    // Analytic (opt-in): enemy hits are predicted from their straight-line paths and reported through
+    // AMainPawn::OnEnemyImpact, with no per-frame physics sweeps.
+    UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Enemies")
+    EEnemyCollisionMode EnemyCollisionMode = EEnemyCollisionMode::Sweep;
+
+    // Gameplay (spawning, enemy motion, lane blends, timers) advances in steps of 1 / GameplayStepHz
+    // whatever the frame rate; enemies and the pawn are drawn interpolated between the last two steps.
+    // 0 = one variable step per frame.
+    UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Simulation", meta = (ClampMin = "0.0"))
+    float GameplayStepHz = 120.f;
+
+    // Catch-up cap: time beyond this many steps in one frame is dropped, so a hitch slows the game down
+    // briefly instead of making the next frames even longer
+    UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Simulation", meta = (ClampMin = "1"))
+    int32 MaxGameplayStepsPerFrame = 8;
+
+    // Scales enemy caps, spawn rate and (optionally) enemy visuals down while frames run over budget.
+    // Never active in headless runs, which have no frame budget.
+    UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Performance")
+    FFrameBudgetSettings FrameBudget;
+
     UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Level Progression")
     TArray<FLevelProgression> Levels;
 
+    // Fixed seed for every run; 0 = a new seed per run. Tunnelz.Run.Seed or -RunSeed=N override it.
+    UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Level Progression")
+    int32 RunSeed = 0;
+
+    // Spawn events generated up front at StartRun, in seconds of play; later ones are generated as
+    // the run reaches them. 0 = generate everything on the fly (same events either way).
+    UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Level Progression", meta = (ClampMin = "0.0"))
+    float PrecomputedTimelineSec = 0.f;
+
+    // Pooled enemies per class on top of the largest MaxNumActiveEnemies that can spawn it,
+    // covering frozen enemies that are still drifting towards the player
+    UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Enemy Pool", meta = (ClampMin = "0"))
+    int32 EnemyPoolHeadroom = 6;
+
+    // Pooled enemies spawned per frame for a level whose classes finish streaming in mid-run; one per
+    // frame while the frame budget governor measures the game thread over its target
+    UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Enemy Pool", meta = (ClampMin = "1"))
+    int32 EnemyPrewarmPerFrame = 2;
+
+    // Minimum distance between spawn slots; 0 = twice the largest enemy bounding radius in the first two levels
+    UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Enemies", meta = (ClampMin = "0.0"))
+    float SpawnSlotSpacing = 0.f;
+
 private:
     FBox EnemySpawnAABB;
+    FSpawnSlotAllocator SpawnSlots;
+    FEnemySpawnStats SpawnStats;
+
+    FSpawnSchedule SpawnSchedule;
+    TArray<FSpawnEvent> SpawnTimeline; // precomputed head of the schedule
+    int32 SpawnTimelineCursor = 0;
+    FSpawnEvent PendingSpawn;
+    bool bHasPendingSpawn = false;
+    int32 CurrentRunSeed = 0;
+    int32 NextRunSeed = 0;
+
+    TUniquePtr<FHeadlessSim> Headless;
+
+    FFrameBudgetGovernor FrameGovernor;
+    float SpawnCredit = 0.f; // spawn events are kept while it reaches 1, adding the density per event
+
+    FLevelAssetStreamer EnemyClassStreamer;
+    TMap<TSoftClassPtr<AEnemyActor>, int32> PrewarmCounts;
+    TArray<int32> PendingPrewarmLevels; // loaded mid-run, pooled a few enemies per frame
+
+    // Cold-start probes (FPlatformTime::Seconds)
+    int32 BootFrames = 0;          // frames ticked since BeginPlay, until the menu has been drawn
+    double BeginPlayTime = 0.0;
+    double RunStartTime = 0.0;
+    double RunClassWaitSec = 0.0;
+    double RunPrewarmSec = 0.0;
+    bool bFirstSpawnPending = false;
 
     int CurLevel = 0;
-    float NextLevelTimer = 0.f;
-    float SpawnTimer = 0.f;
-    int NumAliveEnemies = 0;
+    float RunTime = 0.f;
+    float StepAccumulator = 0.f;
+    int32 NumCappedFrames = 0; // frames that hit MaxGameplayStepsPerFrame this run
     unsigned int Score = 0;
     bool bHasNewHighScore = false;
 
     UPROPERTY(Transient)
     TObjectPtr<UHighScoreSaveGame> SaveHighScoreSG = nullptr;
+
+    // Saves requested within SaveCoalesceSec of each other, or while one is being written, go out as one
+    FRunHistoryFile RunHistory;
+    double SaveDueTime = 0.0;
+    bool bSaveLoaded = false; // the slot has been read (or found empty); saving before that would clobber it
+    bool bSavePending = false;
+    UE::Tasks::TTask<bool> SaveTask; // slot write in flight, if valid and not completed
+
+    UPROPERTY(Transient)
+    TObjectPtr<UEnemyPool> EnemyPool = nullptr;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UEnemyRegistry> EnemyRegistry = nullptr;
 };
\ No newline at end of file
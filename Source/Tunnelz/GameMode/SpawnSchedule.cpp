@@ -0,0 +1,176 @@
+#include "SpawnSchedule.h"
+#include "MainGameMode.h"
+#include "Kismet/GameplayStatics.h"
+
+// -------- Alias table --------
+
+void FAliasTable::Build(TConstArrayView<float> Weights)
+{
+    const int32 N = Weights.Num();
+    Prob.Reset();
+    Alias.Reset();
+
+    double Total = 0.0;
+    for (const float W : Weights)
+        Total += FMath::Max(W, 0.f);
+    if (N == 0 || Total <= 0.0)
+        return;
+
+    Prob.SetNumUninitialized(N);
+    Alias.SetNumUninitialized(N);
+
+    // Scale so the average column is 1, then pair each short column with a long one
+    TArray<double> Scaled;
+    Scaled.SetNumUninitialized(N);
+    TArray<int32> Small, Large;
+    for (int32 i = 0; i < N; ++i)
+    {
+        Scaled[i] = FMath::Max(Weights[i], 0.f) * N / Total;
+        (Scaled[i] < 1.0 ? Small : Large).Add(i);
+    }
+
+    while (Small.Num() > 0 && Large.Num() > 0)
+    {
+        const int32 S = Small.Pop(EAllowShrinking::No);
+        const int32 L = Large.Pop(EAllowShrinking::No);
+        Prob[S] = float(Scaled[S]);
+        Alias[S] = L;
+        Scaled[L] = (Scaled[L] + Scaled[S]) - 1.0;
+        (Scaled[L] < 1.0 ? Small : Large).Add(L);
+    }
+
+    // Leftovers are 1 up to rounding
+    for (const int32 i : Large)
+    {
+        Prob[i] = 1.f;
+        Alias[i] = i;
+    }
+    for (const int32 i : Small)
+    {
+        Prob[i] = 1.f;
+        Alias[i] = i;
+    }
+}
+
+int32 FAliasTable::Pick(FRandomStream& Rng) const
+{
+    if (Prob.Num() == 0)
+        return INDEX_NONE;
+
+    const int32 Column = Rng.RandHelper(Prob.Num());
+    return Rng.GetFraction() < Prob[Column] ? Column : Alias[Column];
+}
+
+// -------- Schedule --------
+
+void FSpawnSchedule::Compile(TConstArrayView<FLevelProgression> InLevels)
+{
+    Levels.Reset(InLevels.Num());
+
+    float EndTime = 0.f;
+    for (int32 i = 0; i < InLevels.Num(); ++i)
+    {
+        const FLevelProgression& Src = InLevels[i];
+        FCompiledLevel& L = Levels.AddDefaulted_GetRef();
+
+        TArray<float> Weights;
+        for (const FEnemyWeight& W : Src.EnemyWeights)
+        {
+            if (W.Class.IsNull() || W.Weight <= 0.f)
+                continue;
+            L.Classes.Add(W.Class);
+            Weights.Add(W.Weight);
+        }
+        L.Table.Build(Weights);
+
+        L.Interval = FMath::Max(Src.SpawnRateSec, 0.05f);
+        L.Jitter = FMath::Clamp(Src.SpawnJitter, 0.f, 0.95f);
+        EndTime += FMath::Max(Src.DurationSec, 1.f);
+        L.EndTime = (i == InLevels.Num() - 1) ? TNumericLimits<float>::Max() : EndTime;
+    }
+
+    CurLevel = 0;
+    LastTime = 0.f;
+}
+
+void FSpawnSchedule::Start(int32 Seed)
+{
+    Rng.Initialize(Seed);
+    CurLevel = 0;
+    LastTime = 0.f;
+}
+
+float FSpawnSchedule::NextInterval(const FCompiledLevel& L)
+{
+    if (L.Jitter <= 0.f)
+        return L.Interval;
+    return L.Interval * (1.f + Rng.FRandRange(-L.Jitter, L.Jitter));
+}
+
+bool FSpawnSchedule::Next(FSpawnEvent& Out)
+{
+    if (Levels.Num() == 0)
+        return false;
+
+    float Time = LastTime + NextInterval(Levels[CurLevel]);
+
+    // Crossing into the next level restarts the interval from the level's start
+    while (Time > Levels[CurLevel].EndTime)
+    {
+        LastTime = Levels[CurLevel].EndTime;
+        ++CurLevel;
+        Time = LastTime + NextInterval(Levels[CurLevel]);
+    }
+
+    const FCompiledLevel& L = Levels[CurLevel];
+    const int32 Pick = L.Table.Pick(Rng);
+
+    Out.Time = Time;
+    Out.Level = CurLevel;
+    Out.Class = Pick != INDEX_NONE ? L.Classes[Pick] : TSoftClassPtr<AEnemyActor>();
+    LastTime = Time;
+    return true;
+}
+
+void FSpawnSchedule::Precompute(float HorizonSec, TArray<FSpawnEvent>& Out)
+{
+    FSpawnEvent Event;
+    while (Next(Event))
+    {
+        Out.Add(Event);
+        if (Event.Time > HorizonSec)
+            break;
+    }
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GSpawnTimelineCmd(
+    TEXT("Tunnelz.Spawns.Timeline"),
+    TEXT("Tunnelz.Spawns.Timeline [Seconds] [Seed]: prints the spawn schedule (time, level, class) for the current run's seed, or the given one."),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        const AMainGameMode* GM = World ? Cast<AMainGameMode>(UGameplayStatics::GetGameMode(World)) : nullptr;
+        if (!GM)
+        {
+            Ar.Log(TEXT("No game mode (not in a game world?)"));
+            return;
+        }
+
+        const float Seconds = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 30.f;
+        const int32 Seed = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : GM->GetRunSeed();
+
+        FSpawnSchedule Schedule;
+        Schedule.Compile(GM->Levels);
+        Schedule.Start(Seed);
+
+        TArray<FSpawnEvent> Events;
+        Schedule.Precompute(Seconds, Events);
+        Ar.Logf(TEXT("Spawn timeline, seed %d, first %.1f s:"), Seed, Seconds);
+        for (const FSpawnEvent& E : Events)
+        {
+            if (E.Time > Seconds)
+                break;
+            Ar.Logf(TEXT("  %8.2f  L%d  %s"), E.Time, E.Level, *E.Class.GetAssetName());
+        }
+    }));
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "UObject/SoftObjectPtr.h"
+
+class AEnemyActor;
+struct FLevelProgression;
+
+// Vose alias table: O(n) build, O(1) weighted pick (one uniform index, one uniform float)
+class FAliasTable
+{
+public:
+    // Non-positive weights are never picked
+    void Build(TConstArrayView<float> Weights);
+
+    // INDEX_NONE if no weight was positive
+    int32 Pick(FRandomStream& Rng) const;
+
+    int32 Num() const { return Prob.Num(); }
+
+private:
+    TArray<float> Prob;
+    TArray<int32> Alias;
+};
+
+struct FSpawnEvent
+{
+    float Time = 0.f; // seconds since the run started
+    int32 Level = 0;
+    TSoftClassPtr<AEnemyActor> Class; // null if the level has nothing to spawn
+};
+
+// The whole run's spawn times and classes, generated from one seed. Levels are compiled into alias
+// tables once at run start, after which every event is O(1). Level changes follow the same rules as
+// the per-frame timers did: a level lasts DurationSec and restarts the spawn interval when it begins.
+// The last level never ends, so the timeline is open-ended: Next keeps generating past any
+// precomputed part and yields the same events either way.
+class FSpawnSchedule
+{
+public:
+    void Compile(TConstArrayView<FLevelProgression> Levels);
+
+    // Rewinds to t = 0 with a fresh stream
+    void Start(int32 Seed);
+    bool Next(FSpawnEvent& Out);
+
+    // Generates events up to HorizonSec into Out (the first one past it included), advancing the schedule
+    void Precompute(float HorizonSec, TArray<FSpawnEvent>& Out);
+
+    float GetLevelEnd(int32 Level) const { return Levels.IsValidIndex(Level) ? Levels[Level].EndTime : 0.f; }
+
+private:
+    struct FCompiledLevel
+    {
+        FAliasTable Table;
+        TArray<TSoftClassPtr<AEnemyActor>> Classes;
+        float Interval = 1.f;
+        float Jitter = 0.f;
+        float EndTime = 0.f; // run time at which the next level starts; unbounded for the last level
+    };
+
+    float NextInterval(const FCompiledLevel& L);
+
+    TArray<FCompiledLevel> Levels;
+    FRandomStream Rng;
+    int32 CurLevel = 0;
+    float LastTime = 0.f;
+};
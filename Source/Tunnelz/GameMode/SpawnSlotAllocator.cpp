@@ -0,0 +1,139 @@
+#include "SpawnSlotAllocator.h"
+
+FIntVector FSpawnSlotAllocator::CellOf(const FVector& P) const
+{
+    const FVector Local = (P - Volume.Min) / CellSize;
+    return FIntVector(
+        FMath::Clamp(FMath::FloorToInt32(Local.X), 0, Dims.X - 1),
+        FMath::Clamp(FMath::FloorToInt32(Local.Y), 0, Dims.Y - 1),
+        FMath::Clamp(FMath::FloorToInt32(Local.Z), 0, Dims.Z - 1));
+}
+
+void FSpawnSlotAllocator::Build(const FBox& InVolume, float InSpacing, int32 Seed, int32 MaxSlots)
+{
+    Volume = InVolume;
+    Spacing = FMath::Max(InSpacing, 1.f);
+    CellSize = Spacing / UE_SQRT_3;
+    Rng.Initialize(Seed);
+
+    const FVector Extent = Volume.GetSize();
+    Dims = FIntVector(
+        FMath::Max(FMath::CeilToInt32(Extent.X / CellSize), 1),
+        FMath::Max(FMath::CeilToInt32(Extent.Y / CellSize), 1),
+        FMath::Max(FMath::CeilToInt32(Extent.Z / CellSize), 1));
+
+    Slots.Reset();
+    Grid.Init(INDEX_NONE, Dims.X * Dims.Y * Dims.Z);
+
+    // Axes thinner than a cell get no offsets, so candidates stay inside the volume
+    const FVector AxisMask(Extent.X >= CellSize ? 1.f : 0.f, Extent.Y >= CellSize ? 1.f : 0.f, Extent.Z >= CellSize ? 1.f : 0.f);
+
+    auto IsFarEnough = [this](const FVector& P)
+    {
+        const FIntVector C = CellOf(P);
+        for (int32 z = FMath::Max(C.Z - 2, 0); z <= FMath::Min(C.Z + 2, Dims.Z - 1); ++z)
+            for (int32 y = FMath::Max(C.Y - 2, 0); y <= FMath::Min(C.Y + 2, Dims.Y - 1); ++y)
+                for (int32 x = FMath::Max(C.X - 2, 0); x <= FMath::Min(C.X + 2, Dims.X - 1); ++x)
+                {
+                    const int32 Slot = Grid[CellIndex(FIntVector(x, y, z))];
+                    if (Slot != INDEX_NONE && FVector::DistSquared(Slots[Slot], P) < FMath::Square(Spacing))
+                        return false;
+                }
+        return true;
+    };
+
+    auto AddSlot = [this](const FVector& P)
+    {
+        const int32 Slot = Slots.Add(P);
+        Grid[CellIndex(CellOf(P))] = Slot;
+        return Slot;
+    };
+
+    TArray<int32> ActiveList;
+    ActiveList.Add(AddSlot(FVector(
+        Rng.FRandRange(Volume.Min.X, Volume.Max.X),
+        Rng.FRandRange(Volume.Min.Y, Volume.Max.Y),
+        Rng.FRandRange(Volume.Min.Z, Volume.Max.Z))));
+
+    constexpr int32 CandidatesPerSlot = 30;
+    while (ActiveList.Num() > 0 && Slots.Num() < MaxSlots)
+    {
+        const int32 ActiveIdx = Rng.RandRange(0, ActiveList.Num() - 1);
+        const FVector Origin = Slots[ActiveList[ActiveIdx]];
+
+        bool bPlaced = false;
+        for (int32 k = 0; k < CandidatesPerSlot && !bPlaced; ++k)
+        {
+            const FVector Dir = (Rng.GetUnitVector() * AxisMask).GetSafeNormal();
+            if (Dir.IsZero())
+                continue;
+
+            const FVector P = Origin + Dir * Rng.FRandRange(Spacing, 2.f * Spacing);
+            if (Volume.IsInsideOrOn(P) && IsFarEnough(P))
+            {
+                ActiveList.Add(AddSlot(P));
+                bPlaced = true;
+            }
+        }
+
+        if (!bPlaced)
+            ActiveList.RemoveAtSwap(ActiveIdx, 1, EAllowShrinking::No);
+    }
+
+    Taken.Init(0, Slots.Num());
+    FreeSlots.Reset(Slots.Num());
+    for (int32 i = 0; i < Slots.Num(); ++i)
+        FreeSlots.Add(i);
+}
+
+void FSpawnSlotAllocator::BeginUpdate()
+{
+    FMemory::Memzero(Taken.GetData(), Taken.Num());
+}
+
+void FSpawnSlotAllocator::Occupy(const FVector& Position)
+{
+    if (Slots.Num() == 0)
+        return;
+
+    // Slots within Spacing of the enemy; anything further than 2 cells away is beyond Spacing
+    const FBox Reach = Volume.ExpandBy(Spacing);
+    if (!Reach.IsInsideOrOn(Position))
+        return;
+
+    const FVector Local = (Position - Volume.Min) / CellSize;
+    const int32 Span = 2;
+    const int32 CX = FMath::FloorToInt32(Local.X), CY = FMath::FloorToInt32(Local.Y), CZ = FMath::FloorToInt32(Local.Z);
+    for (int32 z = FMath::Max(CZ - Span, 0); z <= FMath::Min(CZ + Span, Dims.Z - 1); ++z)
+        for (int32 y = FMath::Max(CY - Span, 0); y <= FMath::Min(CY + Span, Dims.Y - 1); ++y)
+            for (int32 x = FMath::Max(CX - Span, 0); x <= FMath::Min(CX + Span, Dims.X - 1); ++x)
+            {
+                const int32 Slot = Grid[CellIndex(FIntVector(x, y, z))];
+                if (Slot != INDEX_NONE && FVector::DistSquared(Slots[Slot], Position) < FMath::Square(Spacing))
+                    Taken[Slot] = 1;
+            }
+}
+
+void FSpawnSlotAllocator::EndUpdate()
+{
+    FreeSlots.Reset();
+    for (int32 i = 0; i < Slots.Num(); ++i)
+    {
+        if (!Taken[i])
+            FreeSlots.Add(i);
+    }
+}
+
+bool FSpawnSlotAllocator::Acquire(FVector& OutPosition)
+{
+    if (FreeSlots.Num() == 0)
+        return false;
+
+    const int32 Pick = Rng.RandRange(0, FreeSlots.Num() - 1);
+    const int32 Slot = FreeSlots[Pick];
+    FreeSlots.RemoveAtSwap(Pick, 1, EAllowShrinking::No);
+    Taken[Slot] = 1;
+
+    OutPosition = Slots[Slot];
+    return true;
+}
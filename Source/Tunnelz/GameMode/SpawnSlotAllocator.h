@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+// Precomputed Poisson-disk spawn points inside the spawn volume: any two slots are at least Spacing
+// apart, so enemies spawned into free slots never overlap each other. A slot is free when no enemy is
+// within Spacing of it; occupancy is refreshed from enemy positions before spawning, after which
+// Acquire hands out a free slot in O(1).
+class FSpawnSlotAllocator
+{
+public:
+    // Bridson sampling; thin (degenerate) axes are sampled as a plane or line
+    void Build(const FBox& Volume, float InSpacing, int32 Seed, int32 MaxSlots = 2048);
+
+    // Occupancy refresh: BeginUpdate, Occupy for every enemy that may be near the volume, EndUpdate
+    void BeginUpdate();
+    void Occupy(const FVector& Position);
+    void EndUpdate();
+
+    // Random free slot; it stays taken until the next update, which then sees the spawned enemy
+    bool Acquire(FVector& OutPosition);
+
+    int32 NumSlots() const { return Slots.Num(); }
+    float GetSpacing() const { return Spacing; }
+    const FBox& GetVolume() const { return Volume; }
+
+private:
+    FIntVector CellOf(const FVector& P) const;
+    int32 CellIndex(const FIntVector& C) const { return (C.Z * Dims.Y + C.Y) * Dims.X + C.X; }
+
+    FBox Volume = FBox(ForceInit);
+    float Spacing = 100.f;
+    float CellSize = 100.f;
+    FIntVector Dims = FIntVector(1, 1, 1);
+
+    TArray<FVector> Slots;
+    TArray<int32> Grid; // slot per cell (at most one at CellSize = Spacing / sqrt(3)), INDEX_NONE if empty
+    TArray<uint8> Taken;
+    TArray<int32> FreeSlots;
+    FRandomStream Rng;
+};
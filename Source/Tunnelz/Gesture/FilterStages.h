@@ -0,0 +1,263 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <type_traits>
+
+// Composable gyro conditioning stages. A stage is any type with
+//     float Step(float x, float dt);  void Reset();
+// and TFilterChain<A, B, C> feeds each stage's output into the next. The chain is resolved at
+// compile time, so a variant is just a different type: no virtuals, no per-sample branching on
+// configuration, and transcendental math only when dt or a tunable actually changes.
+
+namespace GestureDSP
+{
+    // -------- Small helpers shared by filters --------
+    inline float SoftDZ(float x, float dz)
+    {
+        const float ax = FMath::Abs(x);
+        return (ax <= dz) ? 0.f : FMath::Sign(x) * (ax - dz);
+    }
+
+    // Branch-free min/max network; matches the vectorized kernel bit for bit
+    inline float Median3(float a, float b, float c)
+    {
+        return FMath::Max(FMath::Min(a, b), FMath::Min(FMath::Max(a, b), c));
+    }
+
+    // Exponential smoothing coefficient for time constant Tau
+    inline float EmaAlpha(float dt, float Tau)
+    {
+        return 1.f - FMath::Exp(-dt / FMath::Max(1e-6f, Tau));
+    }
+}
+
+// -------- EMA coefficient, recomputed only when dt or Tau change --------
+struct FCachedEmaAlpha
+{
+    float Get(float dt, float Tau)
+    {
+        if (dt != CachedDt || Tau != CachedTau)
+        {
+            Alpha = GestureDSP::EmaAlpha(dt, Tau);
+            CachedDt = dt;
+            CachedTau = Tau;
+        }
+        return Alpha;
+    }
+
+private:
+    float CachedDt = -1.f;
+    float CachedTau = -1.f;
+    float Alpha = 0.f;
+};
+
+// -------- Median of the last N samples (raw until the window has filled) --------
+template <int32 N>
+struct TMedianStage
+{
+    static_assert(N >= 3 && (N % 2) == 1 && N <= 15, "Median window must be odd and small");
+
+    float Hist[N] = {};
+    int32 HistIdx = 0;
+    bool bFilled = false;
+
+    float Step(float x, float)
+    {
+        Hist[HistIdx] = x;
+        HistIdx = (HistIdx + 1) % N;
+        if (HistIdx == 0) bFilled = true;
+        if (!bFilled) return x;
+
+        if constexpr (N == 3)
+        {
+            return GestureDSP::Median3(Hist[0], Hist[1], Hist[2]);
+        }
+        else
+        {
+            // Insertion sort of a copy; N is tiny
+            float Sorted[N];
+            for (int32 i = 0; i < N; ++i)
+            {
+                const float v = Hist[i];
+                int32 j = i;
+                for (; j > 0 && Sorted[j - 1] > v; --j)
+                    Sorted[j] = Sorted[j - 1];
+                Sorted[j] = v;
+            }
+            return Sorted[N / 2];
+        }
+    }
+
+    void Reset() { *this = TMedianStage(); }
+};
+
+// -------- Plain EMA --------
+struct FEmaStage
+{
+    float Tau = 0.020f; // sec
+
+    float Y = 0.f;
+    FCachedEmaAlpha Alpha;
+
+    float Step(float x, float dt)
+    {
+        Y += (x - Y) * Alpha.Get(dt, Tau);
+        return Y;
+    }
+
+    void Reset() { Y = 0.f; }
+};
+
+// -------- EMA that follows rising magnitude fast and decays slowly --------
+struct FAttackReleaseEmaStage
+{
+    float TauAttack = 0.020f; // sec
+    float TauRelease = 0.080f; // sec
+
+    float LPF = 0.f;
+    FCachedEmaAlpha AttackAlpha;
+    FCachedEmaAlpha ReleaseAlpha;
+
+    float Step(float in, float dt)
+    {
+        const float alpha = (FMath::Abs(in) > FMath::Abs(LPF)) ? AttackAlpha.Get(dt, TauAttack) : ReleaseAlpha.Get(dt, TauRelease);
+        LPF = FMath::Lerp(LPF, in, alpha);
+        return LPF;
+    }
+
+    void Reset() { LPF = 0.f; }
+};
+
+// -------- One-euro filter: cutoff rises with speed, low lag on flicks, smooth at rest --------
+struct FOneEuroStage
+{
+    float MinCutoffHz = 4.f;
+    float Beta = 0.3f;       // cutoff gain per rad/s^2 of slope
+    float SlopeCutoffHz = 1.f;
+
+    float X = 0.f;
+    float DX = 0.f;
+    bool bInit = false;
+
+    // 1 - exp(-dt/tau) ~ dt / (dt + tau); one division, no exp
+    static float Alpha(float dt, float CutoffHz)
+    {
+        const float Tau = 1.f / (2.f * PI * FMath::Max(CutoffHz, 1e-3f));
+        return dt / (dt + Tau);
+    }
+
+    float Step(float x, float dt)
+    {
+        if (!bInit)
+        {
+            X = x;
+            DX = 0.f;
+            bInit = true;
+            return x;
+        }
+
+        const float Slope = (x - X) / FMath::Max(dt, 1e-6f);
+        DX += (Slope - DX) * Alpha(dt, SlopeCutoffHz);
+        X += (x - X) * Alpha(dt, MinCutoffHz + Beta * FMath::Abs(DX));
+        return X;
+    }
+
+    void Reset() { bInit = false; }
+};
+
+// -------- Second-order Butterworth-style low-pass (RBJ), coefficients cached per dt --------
+struct FBiquadLowPassStage
+{
+    float CutoffHz = 25.f;
+    float Q = 0.70710678f;
+
+    float Z1 = 0.f, Z2 = 0.f;
+
+    float Step(float x, float dt)
+    {
+        if (dt != CachedDt || CutoffHz != CachedCutoff || Q != CachedQ)
+            UpdateCoefficients(dt);
+
+        // Transposed direct form II
+        const float y = B0 * x + Z1;
+        Z1 = B1 * x - A1 * y + Z2;
+        Z2 = B2 * x - A2 * y;
+        return y;
+    }
+
+    void Reset() { Z1 = Z2 = 0.f; }
+
+private:
+    void UpdateCoefficients(float dt)
+    {
+        // Keep the cutoff under Nyquist for the current rate
+        const float Fc = FMath::Min(CutoffHz, 0.45f / FMath::Max(dt, 1e-6f));
+        const float W0 = 2.f * PI * Fc * dt;
+        float SinW, CosW;
+        FMath::SinCos(&SinW, &CosW, W0);
+        const float Alpha = SinW / (2.f * FMath::Max(Q, 1e-3f));
+        const float InvA0 = 1.f / (1.f + Alpha);
+
+        B0 = 0.5f * (1.f - CosW) * InvA0;
+        B1 = (1.f - CosW) * InvA0;
+        B2 = B0;
+        A1 = -2.f * CosW * InvA0;
+        A2 = (1.f - Alpha) * InvA0;
+
+        CachedDt = dt;
+        CachedCutoff = CutoffHz;
+        CachedQ = Q;
+    }
+
+    float B0 = 1.f, B1 = 0.f, B2 = 0.f, A1 = 0.f, A2 = 0.f;
+    float CachedDt = -1.f, CachedCutoff = -1.f, CachedQ = -1.f;
+};
+
+// -------- Soft deadzone --------
+struct FDeadzoneStage
+{
+    float Deadzone = 0.05f; // rad/s (~3 deg/s)
+
+    float Step(float x, float) { return GestureDSP::SoftDZ(x, Deadzone); }
+    void Reset() {}
+};
+
+// -------- Compile-time chain --------
+template <typename... TStages>
+struct TFilterChain;
+
+template <>
+struct TFilterChain<>
+{
+    FORCEINLINE float Step(float x, float) { return x; }
+    void Reset() {}
+};
+
+template <typename THead, typename... TRest>
+struct TFilterChain<THead, TRest...>
+{
+    THead Head;
+    TFilterChain<TRest...> Tail;
+
+    FORCEINLINE float Step(float x, float dt) { return Tail.Step(Head.Step(x, dt), dt); }
+    void Reset() { Head.Reset(); Tail.Reset(); }
+
+    // First stage of type TStage in the chain
+    template <typename TStage>
+    TStage& Get()
+    {
+        if constexpr (std::is_same_v<TStage, THead>)
+            return Head;
+        else
+            return Tail.template Get<TStage>();
+    }
+
+    template <typename TStage>
+    const TStage& Get() const
+    {
+        if constexpr (std::is_same_v<TStage, THead>)
+            return Head;
+        else
+            return Tail.template Get<TStage>();
+    }
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GestureDSP.h"
+#include "ImuSample.h"
+#include "OrientationFusion.h"
+
+// Cross-talk and cone gating tunables (mirrored from AMainPawn's Flick|Tuning properties)
+struct FFlickGating
+{
+    float PurityMin = 0.75f;
+    float DominanceRatio = 1.40f;
+    float MinArmMagScale = 0.85f;
+
+    // Narrow to ARM, wider to KEEP once armed (hysteresis)
+    float ArmConeDeg = 16.f;
+    float KeepConeDeg = 28.f;
+};
+
+struct FFlickPipelineResult
+{
+    int UpFlick = 0;    // -1, 0, +1
+    int RightFlick = 0; // -1, 0, +1
+    float Dt = 0.f;     // interval this sample was stepped with
+};
+
+// -------- Sample -> play frame -> filter -> cone/purity gating -> detectors --------
+// The single flick code path: the pawn runs it live, trace replay and tuning run it offline.
+// Each axis can use its own conditioning chain; FFlickPipeline is the shipping configuration.
+template <typename TUpFilter, typename TRightFilter>
+struct TFlickPipeline
+{
+    TAxisChannel<TUpFilter> UpChan;
+    TAxisChannel<TRightFilter> RightChan;
+    FFlickGating Gating;
+    FOrientationFusion Fusion;
+    bool bUseFusion = true;
+
+    // Rate the last Process call fed the channels (play frame when fusion is on)
+    FVector3f LastRate = FVector3f::ZeroVector;
+
+    // Forget the previous timestamp (after a pause or at the start of a trace)
+    void ResetClock() { bHasLastTimestamp = false; }
+
+    // Steps one timestamped sample; NominalDt is used when there is no previous timestamp
+    FFlickPipelineResult Process(const FImuSample& Sample, float NominalDt)
+    {
+        const double RawDt = bHasLastTimestamp ? (Sample.Timestamp - LastTimestamp) : double(NominalDt);
+        const float Dt = float(FMath::Clamp(RawDt, 1e-4, 0.1));
+        LastTimestamp = Sample.Timestamp;
+        bHasLastTimestamp = true;
+
+        // Gravity-aligned rates when enabled; the fusion keeps its estimate across clock resets
+        const FVector3f Rate = bUseFusion ? Fusion.Step(Sample, Dt) : Sample.RotationRate;
+        LastRate = Rate;
+        const float u_raw = Rate.Z; // Up (toward screen top)
+        const float r_raw = Rate.Y; // Right
+        return Step(u_raw, r_raw, Dt);
+    }
+
+    FFlickPipelineResult Step(float u_raw, float r_raw, float Dt)
+    {
+        // -------- Project gyro onto axes & filter each channel --------
+        const float smUp = UpChan.Filter.Step(u_raw, Dt);
+        const float smRight = RightChan.Filter.Step(r_raw, Dt);
+
+        // No roll compensation needed in device space
+        const float upAdj = smUp;
+        const float rightAdj = smRight;
+
+        // Decay/gate per-channel
+        UpChan.Decay(upAdj, Dt);
+        RightChan.Decay(rightAdj, Dt);
+
+        // -------- Cross-talk & cone gating (UP channel) --------
+        const float u = upAdj;
+        const float r = rightAdj;
+        const float uAbs = FMath::Abs(u);
+        const float rAbs = FMath::Abs(r);
+        const float vMag = FMath::Sqrt(u * u + r * r) + 1e-6f;
+
+        const float minArmMag = UpChan.Detector.StartRateRad * Gating.MinArmMagScale;
+        const bool  rightDom = (rAbs > uAbs * Gating.DominanceRatio) && (rAbs > minArmMag);
+
+        const float angUp = FMath::Atan2(r, u); // 0=Up, +90deg=Right
+        const float armConeRad = FMath::DegreesToRadians(Gating.ArmConeDeg);
+        const float keepConeRad = FMath::DegreesToRadians(Gating.KeepConeDeg);
+
+        const bool bUpArmed = (UpChan.Detector.State == FFlickDetector::EState::Armed);
+        const bool inCone = (FMath::Abs(angUp) <= (bUpArmed ? keepConeRad : armConeRad));
+
+        const float purityUp = uAbs / vMag;
+        const bool  purityOk = (purityUp >= Gating.PurityMin) || (vMag < minArmMag);
+
+        const float feedUp = (inCone && purityOk && !rightDom) ? u : 0.f;
+
+        if (rightDom && UpChan.Detector.State == FFlickDetector::EState::Idle)
+            UpChan.Detector.ResetDebounce();
+
+        // -------- Mirror for RIGHT channel (center cone at +-90deg) --------
+        const float angRight = angUp - PI * 0.5f;
+        const bool  bRightArmed = (RightChan.Detector.State == FFlickDetector::EState::Armed);
+        const bool  inRightCone = (FMath::Abs(angRight) <= (bRightArmed ? keepConeRad : armConeRad));
+
+        const float purityRight = rAbs / vMag;
+        const bool  purityRightOk = (purityRight >= Gating.PurityMin) || (vMag < minArmMag);
+        const bool  upDom = (uAbs > rAbs * Gating.DominanceRatio) && (uAbs > minArmMag);
+
+        const float feedRight = (inRightCone && purityRightOk && !upDom) ? r : 0.f;
+
+        if (upDom && RightChan.Detector.State == FFlickDetector::EState::Idle)
+            RightChan.Detector.ResetDebounce();
+
+        // -------- Submit detectors --------
+        FFlickPipelineResult Result;
+        Result.UpFlick = UpChan.Submit(feedUp, u, Dt);
+        Result.RightFlick = RightChan.Submit(feedRight, r, Dt);
+        Result.Dt = Dt;
+        return Result;
+    }
+
+private:
+    double LastTimestamp = 0.0;
+    bool bHasLastTimestamp = false;
+};
+
+struct FFlickPipeline : TFlickPipeline<FAxisFilter, FAxisFilter>
+{
+};
@@ -0,0 +1,179 @@
+#include "FlickRateCheck.h"
+#include "Math/RandomStream.h"
+
+#include "FlickPipeline.h"
+
+namespace
+{
+    // Gestures are spaced well past cooldown + rest so each one is judged on its own
+    const FlickRateCheck::FGesture GScript[] =
+    {
+        { TEXT("strong up"),        0.5, 0, +5.0f,  0.12f, true  },
+        { TEXT("opposite up"),      1.7, 0, -4.0f,  0.12f, false }, // outside the up cone
+        { TEXT("strong right"),     2.9, 1, +4.5f,  0.14f, true  },
+        { TEXT("wobble up"),        4.1, 0, +0.6f,  0.15f, false }, // never above End
+        { TEXT("slow tilt right"),  5.0, 1, +0.95f, 0.60f, false }, // above End, below Start
+        { TEXT("moderate up"),      6.4, 0, +2.2f,  0.10f, true  },
+        { TEXT("moderate right"),   7.6, 1, +2.5f,  0.16f, true  },
+        { TEXT("spike right"),      8.8, 1, +1.6f,  0.05f, false }, // shorter than the filters let through
+    };
+
+    constexpr double ScriptTailSec = 1.2;
+    constexpr double MatchWindowSec = 0.4; // after the gesture ends
+
+    // Flat grip pass: screen up, tipped a hair toward the player so gravity's Y is slightly negative,
+    // then raised to portrait and given a few fusion time constants to settle before the script
+    constexpr double FlatGripSec = 0.1;
+    constexpr double GripLeadInSec = 2.0;
+    const FVector3f FlatGripUp = FVector3f(0.f, -0.02f, 1.f).GetUnsafeNormal();
+    const FVector3f PortraitGripUp = FVector3f(0.f, 1.f, 0.f);
+
+    FVector2f RenderRates(double t)
+    {
+        FVector2f UpRight(0.f, 0.f);
+        for (const FlickRateCheck::FGesture& G : GScript)
+        {
+            const double Phase = (t - G.StartSec) / G.DurationSec;
+            if (Phase >= 0.0 && Phase < 1.0)
+                UpRight[G.Axis] += G.PeakRad * float(FMath::Sin(PI * Phase));
+        }
+        return UpRight;
+    }
+}
+
+TConstArrayView<FlickRateCheck::FGesture> FlickRateCheck::GetScript()
+{
+    return GScript;
+}
+
+FlickRateCheck::FRateResult FlickRateCheck::RunAtRate(const FFlickPipeline& Config, float RateHz, float JitterFraction, bool bFlatGripStart)
+{
+    const TConstArrayView<FGesture> Script = GetScript();
+    const double Nominal = 1.0 / FMath::Max(RateHz, 1.f);
+    const double LeadIn = bFlatGripStart ? GripLeadInSec : 0.0;
+    const double EndSec = LeadIn + Script.Last().StartSec + Script.Last().DurationSec + ScriptTailSec;
+
+    FRateResult Result;
+    Result.RateHz = RateHz;
+    Result.Fired.SetNumZeroed(Script.Num());
+    Result.LatencySec.SetNumZeroed(Script.Num());
+
+    FFlickPipeline Pipeline = Config;
+    Pipeline.ResetClock();
+    Pipeline.Fusion.Reset();
+    FRandomStream Rng(0x7a7e);
+
+    FImuSample Sample;
+    for (double t = Nominal; t < EndSec; t += Nominal * (1.0 + Rng.FRandRange(-JitterFraction, JitterFraction)))
+    {
+        const double ScriptT = t - LeadIn;
+        const FVector2f UpRight = RenderRates(ScriptT);
+        Sample.Timestamp = t;
+        Sample.RotationRate = FVector3f(0.f, UpRight[1], UpRight[0]);
+        if (bFlatGripStart)
+            Sample.Gravity = (t < FlatGripSec ? FlatGripUp : PortraitGripUp) * Config.Fusion.ReadingSign; // as the platform reports it
+
+        const FFlickPipelineResult R = Pipeline.Process(Sample, float(Nominal));
+        for (uint8 Axis = 0; Axis < 2; ++Axis)
+        {
+            const int Dir = (Axis == 0) ? R.UpFlick : R.RightFlick;
+            if (Dir == 0)
+                continue;
+
+            const int32 Index = Script.IndexOfByPredicate([&](const FGesture& G)
+            {
+                return G.Axis == Axis && ScriptT >= G.StartSec && ScriptT <= G.StartSec + G.DurationSec + MatchWindowSec;
+            });
+            if (Index == INDEX_NONE || Result.Fired[Index] != 0)
+            {
+                ++Result.NumSpurious;
+                continue;
+            }
+            Result.Fired[Index] = int8(Dir);
+            Result.LatencySec[Index] = float(ScriptT - (Script[Index].StartSec + Script[Index].DurationSec));
+        }
+    }
+    return Result;
+}
+
+static bool RunPass(const FFlickPipeline& Config, const FlickRateCheck::FSettings& Settings, bool bFlatGripStart, FOutputDevice& Ar)
+{
+    using namespace FlickRateCheck;
+
+    TArray<FRateResult> Results;
+    for (const float Hz : Settings.RatesHz)
+        Results.Add(RunAtRate(Config, Hz, Settings.JitterFraction, bFlatGripStart));
+
+    const float SlowestHz = FMath::Max(1.f, FMath::Min(Settings.RatesHz));
+    const float MaxSpread = 1.f / SlowestHz + Settings.LatencySpreadSlackSec;
+
+    FString Header = FString::Printf(TEXT("  %-16s"), TEXT("gesture"));
+    for (const FRateResult& R : Results)
+        Header += FString::Printf(TEXT(" %8.0fHz"), R.RateHz);
+    Ar.Logf(TEXT("Flick rate check%s (jitter +-%.0f%%, fire latency after gesture end in ms):"),
+        bFlatGripStart ? TEXT(", flat grip start") : TEXT(""), Settings.JitterFraction * 100.f);
+    Ar.Log(Header);
+
+    bool bPass = true;
+    const TConstArrayView<FGesture> Script = GetScript();
+    for (int32 g = 0; g < Script.Num(); ++g)
+    {
+        const FGesture& G = Script[g];
+        const int8 ExpectedDir = G.bExpectFire ? int8(FMath::Sign(G.PeakRad)) : 0;
+
+        FString Line = FString::Printf(TEXT("  %-16s"), G.Name);
+        float MinLatency = TNumericLimits<float>::Max(), MaxLatency = 0.f;
+        bool bRowOk = true;
+        for (const FRateResult& R : Results)
+        {
+            if (R.Fired[g] != ExpectedDir)
+            {
+                bRowOk = false;
+                Line += FString::Printf(TEXT(" %10s"), R.Fired[g] ? TEXT("FIRED") : TEXT("MISSED"));
+                continue;
+            }
+            if (ExpectedDir == 0)
+            {
+                Line += FString::Printf(TEXT(" %10s"), TEXT("-"));
+                continue;
+            }
+            MinLatency = FMath::Min(MinLatency, R.LatencySec[g]);
+            MaxLatency = FMath::Max(MaxLatency, R.LatencySec[g]);
+            bRowOk &= R.LatencySec[g] <= Settings.MaxLatencySec;
+            Line += FString::Printf(TEXT(" %10.1f"), R.LatencySec[g] * 1e3f);
+        }
+
+        if (ExpectedDir != 0 && MaxLatency >= MinLatency)
+        {
+            const float Spread = MaxLatency - MinLatency;
+            bRowOk &= Spread <= MaxSpread;
+            Line += FString::Printf(TEXT("   spread %.1fms"), Spread * 1e3f);
+        }
+        Line += bRowOk ? TEXT("") : TEXT("   <-- FAIL");
+        bPass &= bRowOk;
+        Ar.Log(Line);
+    }
+
+    for (const FRateResult& R : Results)
+    {
+        if (R.NumSpurious > 0)
+        {
+            Ar.Logf(TEXT("  %.0fHz: %d spurious fire(s)"), R.RateHz, R.NumSpurious);
+            bPass = false;
+        }
+    }
+
+    Ar.Logf(TEXT("Flick rate check%s %s (max latency %.0fms, max spread %.1fms)"), bFlatGripStart ? TEXT(", flat grip start,") : TEXT(""),
+        bPass ? TEXT("PASSED") : TEXT("FAILED"), Settings.MaxLatencySec * 1e3f, MaxSpread * 1e3f);
+    return bPass;
+}
+
+bool FlickRateCheck::Run(const FFlickPipeline& Config, const FSettings& Settings, FOutputDevice& Ar)
+{
+    if (Settings.RatesHz.IsEmpty())
+        return false;
+
+    const bool bDeviceAxes = RunPass(Config, Settings, false, Ar);
+    const bool bFlatGrip = RunPass(Config, Settings, true, Ar);
+    return bDeviceAxes && bFlatGrip;
+}
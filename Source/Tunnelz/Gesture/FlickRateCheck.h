@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FFlickPipeline;
+
+// Sample-rate independence check for the flick pipeline.
+// Renders one scripted motion (strong and moderate flicks, opposite-direction flicks, a slow tilt,
+// a wobble and a short spike) at several sample rates, runs each through a copy of the pipeline
+// and requires the same fire decisions at every rate with bounded, consistent latency.
+// A second pass starts with the device lying flat and raises it to the portrait grip before the
+// script, so the gravity-aligned play frame has to settle on the right up from an ambiguous start.
+// Run with "Tunnelz.Flick.RateCheck [Hz...]" or headless with -run=FlickRateCheck.
+namespace FlickRateCheck
+{
+    // One scripted half-sine rotation pulse
+    struct FGesture
+    {
+        const TCHAR* Name = TEXT("");
+        double StartSec = 0.0;
+        uint8 Axis = 0;         // 0 = up, 1 = right
+        float PeakRad = 0.f;    // signed peak rate, rad/s
+        float DurationSec = 0.f;
+        bool bExpectFire = false;
+    };
+
+    struct FRateResult
+    {
+        float RateHz = 0.f;
+        TArray<int8> Fired;         // per gesture: fired direction, 0 if none
+        TArray<float> LatencySec;   // per gesture: fire time - gesture end
+        int32 NumSpurious = 0;      // fires outside any gesture's window
+    };
+
+    struct FSettings
+    {
+        TArray<float> RatesHz = { 30.f, 60.f, 90.f, 120.f };
+        float JitterFraction = 0.f;     // +- fraction of the nominal interval, per sample
+        float MaxLatencySec = 0.2f;     // after the gesture ends
+        float LatencySpreadSlackSec = 0.005f; // allowed spread is one interval at the slowest rate plus this
+    };
+
+    TUNNELZ_API TConstArrayView<FGesture> GetScript();
+
+    // bFlatGripStart: gravity readings start flat, then portrait; otherwise there are none (raw device axes)
+    TUNNELZ_API FRateResult RunAtRate(const FFlickPipeline& Config, float RateHz, float JitterFraction, bool bFlatGripStart = false);
+
+    // Logs a per-gesture table; true when every rate agrees with the script and latency stays in bounds
+    TUNNELZ_API bool Run(const FFlickPipeline& Config, const FSettings& Settings, FOutputDevice& Ar);
+}
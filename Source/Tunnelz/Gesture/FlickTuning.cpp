@@ -0,0 +1,176 @@
+#include "FlickTuning.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+    const FFlickTuningParams::FKnobInfo GKnobs[FFlickTuningParams::Num] =
+    {
+        { TEXT("StartRateRad"),   0.5f,  3.0f  },
+        { TEXT("EndRateRad"),     0.2f,  2.0f  },
+        { TEXT("MaxDuration"),    0.1f,  0.6f  },
+        { TEXT("Cooldown"),       0.1f,  1.0f  },
+        { TEXT("TauAttack"),      0.002f, 0.06f },
+        { TEXT("TauRelease"),     0.01f, 0.2f  },
+        { TEXT("Deadzone"),       0.f,   0.3f  },
+        { TEXT("PurityMin"),      0.4f,  1.0f  },
+        { TEXT("DominanceRatio"), 1.0f,  3.0f  },
+        { TEXT("MinArmMagScale"), 0.3f,  1.5f  },
+        { TEXT("ArmConeDeg"),     4.f,   45.f  },
+        { TEXT("KeepConeDeg"),    8.f,   70.f  },
+        { TEXT("EarlyConfidence"), 0.2f, 1.0f  },
+        { TEXT("PlayFrameBlend"), 0.f,   1.f   },
+    };
+}
+
+const FFlickTuningParams::FKnobInfo& FFlickTuningParams::GetKnobInfo(int32 Knob)
+{
+    check(Knob >= 0 && Knob < Num);
+    return GKnobs[Knob];
+}
+
+int32 FFlickTuningParams::FindKnob(const FString& Name)
+{
+    for (int32 k = 0; k < Num; ++k)
+    {
+        if (Name.Equals(GKnobs[k].Name, ESearchCase::IgnoreCase))
+            return k;
+    }
+    return INDEX_NONE;
+}
+
+FFlickTuningParams FFlickTuningParams::FromPipeline(const FFlickPipeline& Pipeline)
+{
+    // Both channels share one set of tunables; read them off the up channel
+    const FFlickDetector& D = Pipeline.UpChan.Detector;
+    const FAttackReleaseEmaStage& Ema = Pipeline.UpChan.Filter.Get<FAttackReleaseEmaStage>();
+    const FDeadzoneStage& DZ = Pipeline.UpChan.Filter.Get<FDeadzoneStage>();
+
+    FFlickTuningParams P;
+    P.Values[StartRateRad] = D.StartRateRad;
+    P.Values[EndRateRad] = D.EndRateRad;
+    P.Values[MaxDuration] = D.MaxDuration;
+    P.Values[Cooldown] = D.Cooldown;
+    P.Values[TauAttack] = Ema.TauAttack;
+    P.Values[TauRelease] = Ema.TauRelease;
+    P.Values[Deadzone] = DZ.Deadzone;
+    P.Values[PurityMin] = Pipeline.Gating.PurityMin;
+    P.Values[DominanceRatio] = Pipeline.Gating.DominanceRatio;
+    P.Values[MinArmMagScale] = Pipeline.Gating.MinArmMagScale;
+    P.Values[ArmConeDeg] = Pipeline.Gating.ArmConeDeg;
+    P.Values[KeepConeDeg] = Pipeline.Gating.KeepConeDeg;
+    P.Values[EarlyConfidence] = D.EarlyConfidence;
+    P.Values[PlayFrameBlend] = Pipeline.Fusion.PlayFrameBlend;
+    return P;
+}
+
+void FFlickTuningParams::ApplyTo(FFlickPipeline& Pipeline) const
+{
+    for (FAxisChannel* Chan : { &Pipeline.UpChan, &Pipeline.RightChan })
+    {
+        Chan->Detector.StartRateRad = Values[StartRateRad];
+        Chan->Detector.EndRateRad = Values[EndRateRad];
+        Chan->Detector.MaxDuration = Values[MaxDuration];
+        Chan->Detector.Cooldown = Values[Cooldown];
+        Chan->Detector.EarlyConfidence = Values[EarlyConfidence];
+        Chan->Filter.Get<FAttackReleaseEmaStage>().TauAttack = Values[TauAttack];
+        Chan->Filter.Get<FAttackReleaseEmaStage>().TauRelease = Values[TauRelease];
+        Chan->Filter.Get<FDeadzoneStage>().Deadzone = Values[Deadzone];
+    }
+    Pipeline.Gating.PurityMin = Values[PurityMin];
+    Pipeline.Gating.DominanceRatio = Values[DominanceRatio];
+    Pipeline.Gating.MinArmMagScale = Values[MinArmMagScale];
+    Pipeline.Gating.ArmConeDeg = Values[ArmConeDeg];
+    Pipeline.Gating.KeepConeDeg = Values[KeepConeDeg];
+    Pipeline.Fusion.PlayFrameBlend = Values[PlayFrameBlend];
+}
+
+void FFlickTuningParams::Clamp()
+{
+    for (int32 k = 0; k < Num; ++k)
+    {
+        Values[k] = FMath::Clamp(Values[k], GKnobs[k].Min, GKnobs[k].Max);
+    }
+
+    // Keep the hysteresis pairs ordered
+    Values[EndRateRad] = FMath::Min(Values[EndRateRad], Values[StartRateRad]);
+    Values[KeepConeDeg] = FMath::Max(Values[KeepConeDeg], Values[ArmConeDeg]);
+}
+
+bool FFlickTuningScore::Dominates(const FFlickTuningScore& Other) const
+{
+    const float P = Precision(), R = Recall(), L = MeanLatencyMs();
+    const float OP = Other.Precision(), OR = Other.Recall(), OL = Other.MeanLatencyMs();
+    const bool bNoWorse = P >= OP && R >= OR && L <= OL;
+    const bool bBetter = P > OP || R > OR || L < OL;
+    return bNoWorse && bBetter;
+}
+
+bool FlickTuning::LoadLabels(const FString& CsvPath, TArray<FFlickEvent>& OutLabels)
+{
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *CsvPath))
+        return false;
+
+    for (const FString& Line : Lines)
+    {
+        TArray<FString> Cols;
+        if (Line.ParseIntoArray(Cols, TEXT(",")) < 3 || !Cols[0].IsNumeric())
+            continue; // header or junk
+
+        FFlickEvent E;
+        E.Time = FCString::Atod(*Cols[0]);
+        E.Axis = Cols[1].TrimStartAndEnd().Equals(TEXT("right"), ESearchCase::IgnoreCase) ? 1 : 0;
+        E.Dir = FCString::Atoi(*Cols[2]) >= 0 ? 1 : -1;
+        OutLabels.Add(E);
+    }
+
+    OutLabels.Sort([](const FFlickEvent& A, const FFlickEvent& B) { return A.Time < B.Time; });
+    return true;
+}
+
+void FlickTuning::ScoreEvents(TConstArrayView<FFlickEvent> Events, TConstArrayView<FFlickEvent> Labels, FFlickTuningScore& InOutScore)
+{
+    TBitArray<> Used(false, Events.Num());
+
+    // Events and labels are both time-ordered; First skips events too early for any later label
+    int32 First = 0;
+    for (const FFlickEvent& L : Labels)
+    {
+        while (First < Events.Num() && Events[First].Time < L.Time)
+            ++First;
+
+        bool bMatched = false;
+        for (int32 i = First; i < Events.Num() && Events[i].Time <= L.Time + MatchWindowSec; ++i)
+        {
+            if (!Used[i] && Events[i].Axis == L.Axis && Events[i].Dir == L.Dir)
+            {
+                Used[i] = true;
+                bMatched = true;
+                ++InOutScore.TruePositives;
+                InOutScore.LatencySum += Events[i].Time - L.Time;
+                break;
+            }
+        }
+
+        if (!bMatched)
+            ++InOutScore.FalseNegatives;
+    }
+
+    InOutScore.FalsePositives += Events.Num() - Used.CountSetBits();
+}
+
+FFlickTuningScore FlickTuning::Evaluate(const FFlickTuningParams& Params, const FFlickPipeline& Base, TConstArrayView<const FLabeledTrace*> Traces)
+{
+    FFlickTuningScore Score;
+    TArray<FFlickEvent> Events;
+    for (const FLabeledTrace* T : Traces)
+    {
+        FFlickPipeline Pipeline = Base;
+        Params.ApplyTo(Pipeline);
+
+        Events.Reset();
+        ImuTrace::Replay(T->Trace, Pipeline, Events);
+        ScoreEvents(Events, T->Labels, Score);
+    }
+    return Score;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FlickPipeline.h"
+#include "ImuTrace.h"
+
+// Offline tuning of the flick pipeline against labeled traces.
+// A label file sits next to its trace (Foo.tzimu -> Foo.labels.csv) and uses the replay CSV
+// layout, time_s,axis,dir, with time_s at gesture onset.
+
+// Every tunable the search may move, as a flat vector
+struct FFlickTuningParams
+{
+    enum EKnob : int32
+    {
+        StartRateRad, EndRateRad, MaxDuration, Cooldown,
+        TauAttack, TauRelease, Deadzone,
+        PurityMin, DominanceRatio, MinArmMagScale, ArmConeDeg, KeepConeDeg,
+        EarlyConfidence, // only moves results when the base pipeline has early commit on
+        PlayFrameBlend,
+        Num
+    };
+
+    struct FKnobInfo
+    {
+        const TCHAR* Name;
+        float Min;
+        float Max;
+    };
+
+    float Values[Num] = {};
+
+    static const FKnobInfo& GetKnobInfo(int32 Knob);
+    static int32 FindKnob(const FString& Name);
+
+    static FFlickTuningParams FromPipeline(const FFlickPipeline& Pipeline);
+    void ApplyTo(FFlickPipeline& Pipeline) const;
+    void Clamp();
+};
+
+struct FFlickTuningScore
+{
+    int32 TruePositives = 0;
+    int32 FalsePositives = 0;
+    int32 FalseNegatives = 0;
+    double LatencySum = 0.0;
+
+    float Precision() const { return TruePositives + FalsePositives > 0 ? float(TruePositives) / (TruePositives + FalsePositives) : 0.f; }
+    float Recall() const { return TruePositives + FalseNegatives > 0 ? float(TruePositives) / (TruePositives + FalseNegatives) : 0.f; }
+    float F1() const { const float P = Precision(), R = Recall(); return P + R > 0.f ? 2.f * P * R / (P + R) : 0.f; }
+    float MeanLatencyMs() const { return TruePositives > 0 ? float(LatencySum / TruePositives * 1e3) : 0.f; }
+
+    // Not worse on precision, recall and latency, strictly better on at least one
+    bool Dominates(const FFlickTuningScore& Other) const;
+};
+
+struct FLabeledTrace
+{
+    FString Path;
+    FImuTraceView Trace;
+    TArray<FFlickEvent> Labels;
+};
+
+namespace FlickTuning
+{
+    // How far after onset a matching flick may fire and still count
+    constexpr double MatchWindowSec = 0.40;
+
+    TUNNELZ_API bool LoadLabels(const FString& CsvPath, TArray<FFlickEvent>& OutLabels);
+
+    // Greedy one-to-one matching of detected events against labels of the same axis and direction
+    TUNNELZ_API void ScoreEvents(TConstArrayView<FFlickEvent> Events, TConstArrayView<FFlickEvent> Labels, FFlickTuningScore& InOutScore);
+
+    // Replays every trace with Params applied on top of Base
+    TUNNELZ_API FFlickTuningScore Evaluate(const FFlickTuningParams& Params, const FFlickPipeline& Base, TConstArrayView<const FLabeledTrace*> Traces);
+}
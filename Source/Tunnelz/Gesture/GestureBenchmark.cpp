@@ -0,0 +1,277 @@
+#include "GestureBenchmark.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+#include "FlickPipeline.h"
+#include "GestureDSP.h"
+#include "GestureRecognizer.h"
+#include "OrientationFusion.h"
+
+namespace
+{
+    constexpr float BenchDt = 1.f / 240.f;
+
+    // Noisy gyro with periodic flick-shaped pulses, interleaved [Step][Axis]
+    TArray<float> MakeSignal(int32 NumAxes, int32 NumSteps)
+    {
+        FRandomStream Rng(1234);
+        TArray<float> Samples;
+        Samples.SetNumUninitialized(NumAxes * NumSteps);
+        for (int32 s = 0; s < NumSteps; ++s)
+        {
+            for (int32 a = 0; a < NumAxes; ++a)
+            {
+                const int32 Phase = (s + a * 37) % 240;
+                const float Pulse = (Phase < 30) ? 4.f * FMath::Sin(PI * Phase / 30.f) : 0.f;
+                Samples[s * NumAxes + a] = Pulse + Rng.FRandRange(-0.1f, 0.1f);
+            }
+        }
+        return Samples;
+    }
+
+    // Tilted, slowly swaying grip with flick pulses on both axes and a little linear acceleration
+    TArray<FImuSample> MakeImuSamples(int32 NumSteps)
+    {
+        FRandomStream Rng(4321);
+        TArray<FImuSample> Samples;
+        Samples.SetNum(NumSteps);
+        for (int32 s = 0; s < NumSteps; ++s)
+        {
+            const float t = s * BenchDt;
+            const float Lean = 0.5f + 0.2f * FMath::Sin(0.7f * t);
+            const int32 Phase = s % 240;
+            const float Pulse = (Phase < 30) ? 4.f * FMath::Sin(PI * Phase / 30.f) : 0.f;
+
+            FImuSample& S = Samples[s];
+            S.Timestamp = t;
+            S.Gravity = FVector3f(0.f, FMath::Cos(Lean), FMath::Sin(Lean));
+            S.Accel = S.Gravity + FVector3f(Rng.FRandRange(-0.05f, 0.05f), Rng.FRandRange(-0.05f, 0.05f), Rng.FRandRange(-0.05f, 0.05f));
+            S.RotationRate = FVector3f(Rng.FRandRange(-0.1f, 0.1f), (s / 240) % 2 ? Pulse : 0.f, (s / 240) % 2 ? 0.f : Pulse);
+        }
+        return Samples;
+    }
+
+    template <typename TFilter>
+    GestureBenchmark::FResult RunChain(const TCHAR* Name, int32 NumAxes, int32 NumSteps)
+    {
+        const TArray<float> Signal = MakeSignal(NumAxes, NumSteps);
+        TArray<TFilter> Filters;
+        Filters.SetNum(NumAxes);
+
+        GestureBenchmark::FResult R;
+        R.Name = Name;
+        R.NumAxes = NumAxes;
+
+        const double Start = FPlatformTime::Seconds();
+        const float* Src = Signal.GetData();
+        for (int32 s = 0; s < NumSteps; ++s, Src += NumAxes)
+        {
+            for (int32 a = 0; a < NumAxes; ++a)
+            {
+                R.Checksum += Filters[a].Step(Src[a], BenchDt);
+            }
+        }
+        R.Seconds = FPlatformTime::Seconds() - Start;
+        R.NumSamples = int64(NumAxes) * NumSteps;
+        return R;
+    }
+
+    void Report(const GestureBenchmark::FResult& R, FOutputDevice& Ar)
+    {
+        Ar.Logf(TEXT("  %-22s axes=%3d  %10.2f ns/sample  %8.2f Msamples/s  (checksum %.3f)"),
+            R.Name, R.NumAxes, R.NsPerSample(), R.SamplesPerSec() / 1e6, R.Checksum);
+    }
+}
+
+GestureBenchmark::FResult GestureBenchmark::RunScalarFilter(int32 NumAxes, int32 NumSteps)
+{
+    return RunChain<FAxisFilter>(TEXT("Scalar FAxisFilter"), NumAxes, NumSteps);
+}
+
+GestureBenchmark::FResult GestureBenchmark::RunOneEuroChain(int32 NumAxes, int32 NumSteps)
+{
+    return RunChain<TFilterChain<TMedianStage<3>, FOneEuroStage, FDeadzoneStage>>(TEXT("Median3+OneEuro+DZ"), NumAxes, NumSteps);
+}
+
+GestureBenchmark::FResult GestureBenchmark::RunBiquadChain(int32 NumAxes, int32 NumSteps)
+{
+    return RunChain<TFilterChain<TMedianStage<5>, FBiquadLowPassStage, FDeadzoneStage>>(TEXT("Median5+Biquad+DZ"), NumAxes, NumSteps);
+}
+
+GestureBenchmark::FResult GestureBenchmark::RunFilterBank(int32 NumAxes, int32 NumSteps)
+{
+    const TArray<float> Signal = MakeSignal(NumAxes, NumSteps);
+    FAxisFilterBank Bank;
+    Bank.Init(NumAxes);
+    TArray<float> Out;
+    Out.SetNumZeroed(NumAxes);
+
+    FResult R;
+    R.Name = TEXT("SIMD FAxisFilterBank");
+    R.NumAxes = NumAxes;
+
+    const double Start = FPlatformTime::Seconds();
+    const float* Src = Signal.GetData();
+    for (int32 s = 0; s < NumSteps; ++s, Src += NumAxes)
+    {
+        Bank.Step(Src, Out.GetData(), BenchDt);
+        R.Checksum += Out[s % NumAxes];
+    }
+    R.Seconds = FPlatformTime::Seconds() - Start;
+    R.NumSamples = int64(NumAxes) * NumSteps;
+    return R;
+}
+
+GestureBenchmark::FResult GestureBenchmark::RunBankWithDetectors(int32 NumAxes, int32 NumSteps)
+{
+    const TArray<float> Signal = MakeSignal(NumAxes, NumSteps);
+    FAxisFilterBank Bank;
+    Bank.Init(NumAxes);
+    TArray<FFlickDetector> Detectors;
+    Detectors.SetNum(NumAxes);
+    TArray<float> Out;
+    Out.SetNumZeroed(NumAxes);
+
+    FResult R;
+    R.Name = TEXT("Bank + FFlickDetector");
+    R.NumAxes = NumAxes;
+
+    int32 NumFlicks = 0;
+    const double Start = FPlatformTime::Seconds();
+    const float* Src = Signal.GetData();
+    for (int32 s = 0; s < NumSteps; ++s, Src += NumAxes)
+    {
+        Bank.Step(Src, Out.GetData(), BenchDt);
+        for (int32 a = 0; a < NumAxes; ++a)
+        {
+            NumFlicks += FMath::Abs(Detectors[a].Update(Out[a], BenchDt));
+        }
+    }
+    R.Seconds = FPlatformTime::Seconds() - Start;
+    R.NumSamples = int64(NumAxes) * NumSteps;
+    R.Checksum = float(NumFlicks);
+    return R;
+}
+
+GestureBenchmark::FResult GestureBenchmark::RunFusion(int32 NumStreams, int32 NumSteps)
+{
+    const TArray<FImuSample> Samples = MakeImuSamples(NumSteps);
+    TArray<FOrientationFusion> Fusions;
+    Fusions.SetNum(NumStreams);
+
+    FResult R;
+    R.Name = TEXT("Gravity fusion");
+    R.NumAxes = NumStreams;
+
+    FVector3f Sum = FVector3f::ZeroVector;
+    const double Start = FPlatformTime::Seconds();
+    for (const FImuSample& S : Samples)
+    {
+        for (FOrientationFusion& Fusion : Fusions)
+        {
+            Sum += Fusion.Step(S, BenchDt);
+        }
+    }
+    R.Seconds = FPlatformTime::Seconds() - Start;
+    R.NumSamples = int64(NumStreams) * NumSteps;
+    R.Checksum = Sum.X + Sum.Y + Sum.Z;
+    return R;
+}
+
+GestureBenchmark::FResult GestureBenchmark::RunFlickPipeline(int32 NumStreams, int32 NumSteps)
+{
+    const TArray<FImuSample> Samples = MakeImuSamples(NumSteps);
+    TArray<FFlickPipeline> Pipelines;
+    Pipelines.SetNum(NumStreams);
+
+    FResult R;
+    R.Name = TEXT("Fusion + FFlickPipeline");
+    R.NumAxes = NumStreams;
+
+    int32 NumFlicks = 0;
+    const double Start = FPlatformTime::Seconds();
+    for (const FImuSample& S : Samples)
+    {
+        for (FFlickPipeline& Pipeline : Pipelines)
+        {
+            const FFlickPipelineResult Result = Pipeline.Process(S, BenchDt);
+            NumFlicks += FMath::Abs(Result.UpFlick) + FMath::Abs(Result.RightFlick);
+        }
+    }
+    R.Seconds = FPlatformTime::Seconds() - Start;
+    R.NumSamples = int64(NumStreams) * NumSteps;
+    R.Checksum = float(NumFlicks);
+    return R;
+}
+
+GestureBenchmark::FResult GestureBenchmark::RunTemplateMatch(int32 NumTemplates, int32 NumFrames, bool bSimd)
+{
+    // 240 Hz samples, four per 60 Hz frame, so each frame closes one or two 100 Hz bins
+    constexpr int32 SamplesPerFrame = 4;
+    const TArray<FImuSample> Samples = MakeImuSamples(NumFrames * SamplesPerFrame);
+
+    FGestureRecognizer Recognizer;
+    Recognizer.Init(FGestureRecognizerSettings());
+    Recognizer.bUseSimd = bSimd;
+    const TArray<FGestureTemplate> Defaults = FGestureRecognizer::MakeDefaultTemplates(100.f);
+    for (int32 t = 0; t < NumTemplates; ++t)
+    {
+        FGestureTemplate Template = Defaults[t % Defaults.Num()];
+        Template.Name = FName(*FString::Printf(TEXT("Bench%d"), t));
+        Recognizer.AddTemplate(Template);
+    }
+
+    FResult R;
+    R.Name = bSimd ? TEXT("Template NCC (SIMD)") : TEXT("Template NCC (scalar)");
+    R.NumAxes = NumTemplates;
+
+    TArray<FGestureMatch> Matches;
+    const double Start = FPlatformTime::Seconds();
+    for (int32 f = 0; f < NumFrames; ++f)
+    {
+        for (int32 i = 0; i < SamplesPerFrame; ++i)
+        {
+            const FImuSample& S = Samples[f * SamplesPerFrame + i];
+            Recognizer.Push(S.Timestamp, S.RotationRate);
+        }
+        Recognizer.Evaluate(1.0, Matches);
+    }
+    R.Seconds = FPlatformTime::Seconds() - Start;
+    R.NumSamples = int64(NumTemplates) * NumFrames;
+    R.Checksum = float(Matches.Num());
+    return R;
+}
+
+void GestureBenchmark::RunAll(int32 NumAxes, int32 NumSteps, FOutputDevice& Ar)
+{
+    NumAxes = FMath::Max(1, NumAxes);
+    NumSteps = FMath::Max(1, NumSteps);
+
+    Ar.Logf(TEXT("Gesture DSP benchmark: %d axes x %d steps"), NumAxes, NumSteps);
+    Report(RunScalarFilter(NumAxes, NumSteps), Ar);
+    Report(RunOneEuroChain(NumAxes, NumSteps), Ar);
+    Report(RunBiquadChain(NumAxes, NumSteps), Ar);
+    Report(RunFilterBank(NumAxes, NumSteps), Ar);
+    Report(RunBankWithDetectors(NumAxes, NumSteps), Ar);
+
+    // Per IMU stream (one sample = one timestamped 3-axis reading)
+    Report(RunFusion(NumAxes, NumSteps), Ar);
+    Report(RunFlickPipeline(NumAxes, NumSteps), Ar);
+
+    // Per template per frame
+    Report(RunTemplateMatch(NumAxes, NumSteps / 16, true), Ar);
+    Report(RunTemplateMatch(NumAxes, NumSteps / 16, false), Ar);
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GGestureBenchCmd(
+    TEXT("Tunnelz.Bench.Gesture"),
+    TEXT("Benchmark the gesture DSP library. Usage: Tunnelz.Bench.Gesture [Axes=8] [Steps=200000]"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda(
+        [](const TArray<FString>& Args, UWorld*, FOutputDevice& Ar)
+        {
+            const int32 Axes = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 8;
+            const int32 Steps = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 200000;
+            GestureBenchmark::RunAll(Axes, Steps, Ar);
+        }));
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Microbenchmarks for the gesture DSP library.
+// Run on device with "Tunnelz.Bench.Gesture [Axes] [Steps]" or headless with -run=GestureBenchmark.
+namespace GestureBenchmark
+{
+    struct FResult
+    {
+        const TCHAR* Name = TEXT("");
+        int32 NumAxes = 0;
+        int64 NumSamples = 0; // axis-samples processed
+        double Seconds = 0.0;
+        float Checksum = 0.f; // keeps the optimizer honest
+
+        double NsPerSample() const { return NumSamples > 0 ? (Seconds * 1e9) / double(NumSamples) : 0.0; }
+        double SamplesPerSec() const { return Seconds > 0.0 ? double(NumSamples) / Seconds : 0.0; }
+    };
+
+    // Per-axis scalar FAxisFilter
+    TUNNELZ_API FResult RunScalarFilter(int32 NumAxes, int32 NumSteps);
+
+    // One FAxisFilterBank across all axes
+    TUNNELZ_API FResult RunFilterBank(int32 NumAxes, int32 NumSteps);
+
+    // Alternative conditioning chains, one per axis
+    TUNNELZ_API FResult RunOneEuroChain(int32 NumAxes, int32 NumSteps);
+    TUNNELZ_API FResult RunBiquadChain(int32 NumAxes, int32 NumSteps);
+
+    // Bank filtering plus one FFlickDetector per axis
+    TUNNELZ_API FResult RunBankWithDetectors(int32 NumAxes, int32 NumSteps);
+
+    // Gravity fusion + play-frame projection alone, and the whole flick pipeline, per IMU stream
+    TUNNELZ_API FResult RunFusion(int32 NumStreams, int32 NumSteps);
+    TUNNELZ_API FResult RunFlickPipeline(int32 NumStreams, int32 NumSteps);
+
+    // Gesture recognizer: one sample = one template scored for one frame (all its time-scale variants)
+    TUNNELZ_API FResult RunTemplateMatch(int32 NumTemplates, int32 NumFrames, bool bSimd);
+
+    TUNNELZ_API void RunAll(int32 NumAxes, int32 NumSteps, FOutputDevice& Ar);
+}
@@ -0,0 +1,373 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FilterStages.h"
+
+// Gesture signal processing shared by the pawn, tools and benchmarks.
+// Header-only and engine-independent: Core math and containers only, no UObjects.
+
+// -------- Default signal filter: median3 + attack/decay EMA + soft deadzone --------
+// Other conditioning chains are just other TFilterChain types (see FilterStages.h).
+using FAxisFilter = TFilterChain<TMedianStage<3>, FAttackReleaseEmaStage, FDeadzoneStage>;
+
+// -------- Peak-based, debounced, sign-aware flick detector --------
+// All timing is wall time from the sample intervals (dt), never frame counts, so a flick
+// produces the same decision at any sample rate. Threshold crossings are located by
+// interpolating between samples, so hold and onset times don't snap to the sample grid.
+struct FFlickDetector
+{
+    // Tunables
+    float StartRateRad = 1.1f;
+    float EndRateRad = 0.8f;
+    float MaxDuration = 0.35f; // sec
+    float Cooldown = 0.45f; // external knob; success enforces >= 0.08s
+    float DebounceSec = 0.012f; // time above Start (per sign) before arming
+
+    // Early commit: fire on the rising edge once the flick is predicted to be real
+    bool  bEarlyCommit = false;
+    float EarlyConfidence = 0.6f;     // 0..1 threshold to commit
+    float EarlyMinArmedTime = 0.008f; // sec armed before a commit is considered
+    float EarlyPeakMargin = 0.5f;     // predicted peak must clear Start by this fraction for full confidence
+    float EarlyMinSlope = 40.f;       // rad/s^2 rise for full confidence
+
+    // State
+    enum class EState : uint8 { Idle, Armed } State = EState::Idle;
+    float  Timer = 0.f;
+    float  PeakAbsRate = 0.f;
+    float  PeakSign = +1.f;
+    float  CooldownT = 0.f;
+
+    // Debounce per sign: time held above Start since the interpolated crossing (<0 = below)
+    float PosHeldSec = -1.f, NegHeldSec = -1.f;
+    float PrevRate = 0.f;
+    bool DebAbovePos = false, DebAboveNeg = false;
+    bool PrevDebAbovePos = false, PrevDebAboveNeg = false;
+
+    // Onset-to-fire timing; onset is the last upward crossing of EndRateRad
+    double Clock = 0.0;
+    double OnsetClock = 0.0;
+    double ArmClock = 0.0;
+    float PrevAbsRate = 0.f;
+    float PrevSlope = 0.f;
+    float Confidence = 0.f;
+    bool  bCommitted = false;
+    float LastOnsetToFireSec = 0.f;
+    float LastArmToFireSec = 0.f;
+    int32 NumEarlyCommits = 0;
+    int32 NumRetractedCommits = 0; // committed early, then the flick timed out
+
+    // Rising-edge confidence that the current armed flick will peak above StartRateRad
+    float PredictConfidence(float along, float slope, float jerk) const
+    {
+        float predictedPeak = FMath::Max(PeakAbsRate, along);
+        if (slope > 0.f)
+        {
+            // Parabolic extrapolation while the rise is decelerating, linear over 30ms otherwise
+            predictedPeak = (jerk < 0.f) ? along + (slope * slope) / (2.f * -jerk) : along + slope * 0.03f;
+            predictedPeak = FMath::Max(predictedPeak, PeakAbsRate);
+        }
+
+        const float peakConf = FMath::Clamp((predictedPeak - StartRateRad) / FMath::Max(StartRateRad * EarlyPeakMargin, 1e-3f), 0.f, 1.f);
+        const float slopeConf = FMath::Clamp(slope / FMath::Max(EarlyMinSlope, 1e-3f), 0.f, 1.f);
+        return peakConf * (0.5f + 0.5f * slopeConf);
+    }
+
+    // Part of the last interval [0, dt] spent beyond Threshold, assuming a linear ramp from Prev to Cur
+    static float TimeBeyond(float Prev, float Cur, float Threshold, float dt)
+    {
+        if (Prev >= Threshold) return dt;
+        return dt * FMath::Clamp((Cur - Threshold) / FMath::Max(Cur - Prev, 1e-6f), 0.f, 1.f);
+    }
+
+    // Forget partial holds (cross-talk gating suppressed this channel)
+    void ResetDebounce()
+    {
+        PosHeldSec = NegHeldSec = -1.f;
+    }
+
+    int Update(float rate, float dt)
+    {
+        dt = FMath::Max(dt, 0.f);
+        Clock += dt;
+
+        const float ar = FMath::Abs(rate);
+        const float sgn = (rate >= 0.f) ? +1.f : -1.f;
+
+        const float slope = (ar - PrevAbsRate) / FMath::Max(dt, 1e-4f);
+        const float jerk = (slope - PrevSlope) / FMath::Max(dt, 1e-4f);
+        if (ar > EndRateRad && PrevAbsRate <= EndRateRad)
+            OnsetClock = Clock - TimeBeyond(PrevAbsRate, ar, EndRateRad, dt);
+
+        // Hold time per sign, measured from where the rate crossed Start inside this interval
+        const bool aboveStartPos = (rate > +StartRateRad);
+        const bool aboveStartNeg = (rate < -StartRateRad);
+        PosHeldSec = !aboveStartPos ? -1.f : (PosHeldSec >= 0.f ? PosHeldSec + dt : TimeBeyond(PrevRate, rate, StartRateRad, dt));
+        NegHeldSec = !aboveStartNeg ? -1.f : (NegHeldSec >= 0.f ? NegHeldSec + dt : TimeBeyond(-PrevRate, -rate, StartRateRad, dt));
+
+        PrevAbsRate = ar;
+        PrevSlope = slope;
+        PrevRate = rate;
+
+        if (CooldownT > 0.f)
+        {
+            // A cooldown that expires partway through this interval frees the rest of it
+            const float Left = CooldownT - dt;
+            CooldownT = FMath::Max(0.f, Left);
+            if (Left > 0.f) return 0;
+            PosHeldSec = FMath::Min(PosHeldSec, -Left);
+            NegHeldSec = FMath::Min(NegHeldSec, -Left);
+        }
+
+        DebAbovePos = (PosHeldSec >= DebounceSec);
+        DebAboveNeg = (NegHeldSec >= DebounceSec);
+
+        const bool risingPos = (DebAbovePos && !PrevDebAbovePos);
+        const bool risingNeg = (DebAboveNeg && !PrevDebAboveNeg);
+
+        switch (State)
+        {
+        case EState::Idle:
+        {
+            if (risingPos || risingNeg)
+            {
+                State = EState::Armed;
+                // Start the flick clock at the moment the hold requirement was met, not at this sample
+                Timer = FMath::Max(risingPos ? PosHeldSec : NegHeldSec, 0.f) - DebounceSec;
+                ArmClock = Clock - Timer;
+                PeakAbsRate = ar;
+                PeakSign = sgn;
+                Confidence = 0.f;
+                bCommitted = false;
+            }
+            break;
+        }
+        case EState::Armed:
+        {
+            Timer += dt;
+            if (ar > PeakAbsRate) PeakAbsRate = ar;
+
+            if (bEarlyCommit && !bCommitted && Timer >= EarlyMinArmedTime && (rate * PeakSign) > 0.f)
+            {
+                Confidence = PredictConfidence(ar, slope, jerk);
+                if (Confidence >= EarlyConfidence)
+                {
+                    // Fire now; stay armed so the tail still ends the flick and starts the cooldown
+                    bCommitted = true;
+                    ++NumEarlyCommits;
+                    LastOnsetToFireSec = float(Clock - OnsetClock);
+                    LastArmToFireSec = float(Clock - ArmClock);
+                    PrevDebAbovePos = DebAbovePos;
+                    PrevDebAboveNeg = DebAboveNeg;
+                    return (PeakSign >= 0.f) ? +1 : -1;
+                }
+            }
+
+            const bool aboveEnd = (ar > EndRateRad);
+            const bool sameSign = ((sgn >= 0.f) == (PeakSign >= 0.f));
+
+            const bool timeOut = (Timer > MaxDuration);
+            const bool dropBelowEnd = (!aboveEnd && Timer >= 0.02f);
+            const bool signReversalBeyondEnd = (!sameSign && aboveEnd);
+
+            if (timeOut || dropBelowEnd || signReversalBeyondEnd)
+            {
+                int dir = 0;
+                if (bCommitted)
+                {
+                    // Already fired on the rising edge
+                    CooldownT = FMath::Max(Cooldown, 0.08f);
+                    if (timeOut) ++NumRetractedCommits;
+                }
+                else if (PeakAbsRate >= StartRateRad && !timeOut)
+                {
+                    dir = (PeakSign >= 0.f) ? +1 : -1;
+                    CooldownT = FMath::Max(Cooldown, 0.08f);
+                    LastOnsetToFireSec = float(Clock - OnsetClock);
+                    LastArmToFireSec = float(Clock - ArmClock);
+                }
+                else
+                {
+                    CooldownT = 0.08f;
+                }
+                bCommitted = false;
+
+                State = EState::Idle;
+                Timer = 0.f;
+                PeakAbsRate = 0.f;
+                ResetDebounce();
+
+                PrevDebAbovePos = DebAbovePos;
+                PrevDebAboveNeg = DebAboveNeg;
+                return dir;
+            }
+            break;
+        }
+        }
+
+        PrevDebAbovePos = DebAbovePos;
+        PrevDebAboveNeg = DebAboveNeg;
+        return 0;
+    }
+};
+
+// -------- One per-axis channel: filter + detector + small "rest/cooldown" gate --------
+template <typename TFilter>
+struct TAxisChannel
+{
+    TFilter        Filter;
+    FFlickDetector Detector;
+
+    // Pawn-level rest + manual cooldown (prevents rebound doubles)
+    bool  bNeedsRest = false;
+    float ManualCDT = 0.f;
+    float RestRate = 0.25f; // must dip below this once after a hit
+
+    void Decay(float smoothedRate, float dt)
+    {
+        if (ManualCDT > 0.f) ManualCDT = FMath::Max(0.f, ManualCDT - dt);
+        if (bNeedsRest && FMath::Abs(smoothedRate) < RestRate)
+            bNeedsRest = false;
+    }
+    int Submit(float feedRate, float smoothedForRest, float dt)
+    {
+        const int dir = Detector.Update(feedRate, dt);
+        if (dir == 0) return 0;
+
+        if (ManualCDT <= 0.f && !bNeedsRest)
+        {
+            ManualCDT = 0.18f;
+            bNeedsRest = true;
+            return dir;
+        }
+        return 0;
+    }
+};
+
+using FAxisChannel = TAxisChannel<FAxisFilter>;
+
+// -------- N-axis filter bank (structure of arrays, 4-wide SIMD) --------
+// Same median3 -> attack/release EMA -> soft deadzone chain as FAxisFilter, evaluated for
+// every axis at once. All axes share one sample clock; alphas are only recomputed when dt
+// or a tunable changes, so the per-sample cost is a handful of vector ops per 4 axes.
+struct FAxisFilterBank
+{
+    static constexpr int32 Width = 4;
+
+    void Init(int32 InNumAxes)
+    {
+        NumAxes = FMath::Max(0, InNumAxes);
+        NumPadded = Align(NumAxes, Width);
+
+        const FAttackReleaseEmaStage EmaDefaults;
+        const FDeadzoneStage DeadzoneDefaults;
+        TauAttack.Init(EmaDefaults.TauAttack, NumPadded);
+        TauRelease.Init(EmaDefaults.TauRelease, NumPadded);
+        Deadzone.Init(DeadzoneDefaults.Deadzone, NumPadded);
+        AlphaAttack.Init(0.f, NumPadded);
+        AlphaRelease.Init(0.f, NumPadded);
+        LPF.Init(0.f, NumPadded);
+        Hist.Init(0.f, NumPadded * 3);
+        In.Init(0.f, NumPadded);
+        Out.Init(0.f, NumPadded);
+        Reset();
+    }
+
+    int32 Num() const { return NumAxes; }
+
+    void SetParams(int32 Axis, float InTauAttack, float InTauRelease, float InDeadzone)
+    {
+        check(Axis >= 0 && Axis < NumAxes);
+        TauAttack[Axis] = InTauAttack;
+        TauRelease[Axis] = InTauRelease;
+        Deadzone[Axis] = InDeadzone;
+        CachedDt = -1.f;
+    }
+
+    void Reset()
+    {
+        FMemory::Memzero(LPF.GetData(), LPF.Num() * sizeof(float));
+        FMemory::Memzero(Hist.GetData(), Hist.Num() * sizeof(float));
+        HistIdx = 0;
+        bFilled = false;
+        CachedDt = -1.f;
+    }
+
+    // Raw and Result hold Num() samples, one per axis, all taken at the same instant.
+    void Step(const float* Raw, float* Result, float dt)
+    {
+        if (dt != CachedDt)
+        {
+            for (int32 i = 0; i < NumPadded; ++i)
+            {
+                AlphaAttack[i] = GestureDSP::EmaAlpha(dt, TauAttack[i]);
+                AlphaRelease[i] = GestureDSP::EmaAlpha(dt, TauRelease[i]);
+            }
+            CachedDt = dt;
+        }
+
+        FMemory::Memcpy(In.GetData(), Raw, NumAxes * sizeof(float));
+
+        // The third sample completes the window, same as FAxisFilter
+        const bool bUseMedian = bFilled || (HistIdx == 2);
+        float* Slot = Hist.GetData() + HistIdx * NumPadded;
+        const float* H0 = Hist.GetData();
+        const float* H1 = H0 + NumPadded;
+        const float* H2 = H1 + NumPadded;
+
+        for (int32 i = 0; i < NumPadded; i += Width)
+        {
+            const VectorRegister4Float Raw4 = VectorLoad(In.GetData() + i);
+            VectorStore(Raw4, Slot + i);
+
+            // median(3)
+            VectorRegister4Float In4 = Raw4;
+            if (bUseMedian)
+            {
+                const VectorRegister4Float A = VectorLoad(H0 + i);
+                const VectorRegister4Float B = VectorLoad(H1 + i);
+                const VectorRegister4Float C = VectorLoad(H2 + i);
+                In4 = VectorMax(VectorMin(A, B), VectorMin(VectorMax(A, B), C));
+            }
+
+            // attack / release EMA
+            VectorRegister4Float Lpf4 = VectorLoad(LPF.GetData() + i);
+            const VectorRegister4Float Attack = VectorCompareGT(VectorAbs(In4), VectorAbs(Lpf4));
+            const VectorRegister4Float Alpha4 = VectorSelect(Attack, VectorLoad(AlphaAttack.GetData() + i), VectorLoad(AlphaRelease.GetData() + i));
+            Lpf4 = VectorMultiplyAdd(VectorSubtract(In4, Lpf4), Alpha4, Lpf4);
+            VectorStore(Lpf4, LPF.GetData() + i);
+
+            // soft deadzone: sign(x) * max(|x| - dz, 0)
+            const VectorRegister4Float Mag = VectorMax(VectorSubtract(VectorAbs(Lpf4), VectorLoad(Deadzone.GetData() + i)), VectorZeroFloat());
+            VectorStore(VectorMultiply(VectorSign(Lpf4), Mag), Out.GetData() + i);
+        }
+
+        HistIdx = (HistIdx + 1) % 3;
+        if (HistIdx == 0) bFilled = true;
+
+        FMemory::Memcpy(Result, Out.GetData(), NumAxes * sizeof(float));
+    }
+
+private:
+    int32 NumAxes = 0;
+    int32 NumPadded = 0;
+
+    // Tunables, one lane per axis
+    TArray<float> TauAttack;
+    TArray<float> TauRelease;
+    TArray<float> Deadzone;
+
+    // Alphas cached for CachedDt
+    TArray<float> AlphaAttack;
+    TArray<float> AlphaRelease;
+    float CachedDt = -1.f;
+
+    // State; Hist is three NumPadded-wide rows
+    TArray<float> LPF;
+    TArray<float> Hist;
+    int32 HistIdx = 0;
+    bool bFilled = false;
+
+    // Padded I/O so ragged axis counts never read past the caller's buffers
+    TArray<float> In;
+    TArray<float> Out;
+};
@@ -0,0 +1,119 @@
+#include "GestureLatency.h"
+
+// -------- Histogram --------
+
+void FLatencyHistogram::Add(float Ms)
+{
+    Ms = FMath::Max(Ms, 0.f);
+    const int32 Bucket = FMath::Min(int32(Ms / BucketMs), NumBuckets);
+    ++Buckets[Bucket];
+    ++Count;
+    SumMs += Ms;
+    MaxMs = FMath::Max(MaxMs, Ms);
+}
+
+void FLatencyHistogram::Reset()
+{
+    *this = FLatencyHistogram();
+}
+
+float FLatencyHistogram::GetPercentileMs(float P) const
+{
+    if (Count == 0)
+        return 0.f;
+
+    const double Rank = FMath::Clamp(P, 0.f, 1.f) * Count;
+    double Below = 0.0;
+    for (int32 i = 0; i < NumBuckets; ++i)
+    {
+        if (Buckets[i] > 0 && Below + Buckets[i] >= Rank)
+            return FMath::Min(float((i + (Rank - Below) / Buckets[i]) * BucketMs), MaxMs);
+        Below += Buckets[i];
+    }
+    return MaxMs;
+}
+
+// -------- Tracker --------
+
+void FGestureLatencyTracker::Fire(int32 Axis, double OnsetTime, double ArmTime, double FireTime, double ArrivalTime)
+{
+    check(Axis >= 0 && Axis < NumAxes);
+    FRecord& R = Open[Axis];
+    R = FRecord();
+    R.Times[int32(EGestureProbe::Onset)] = OnsetTime;
+    R.Times[int32(EGestureProbe::Arm)] = ArmTime;
+    R.Times[int32(EGestureProbe::Fire)] = FireTime;
+    R.Times[int32(EGestureProbe::Arrival)] = ArrivalTime;
+    R.bOpen = true;
+}
+
+void FGestureLatencyTracker::ActionStart(int32 Axis, double Now)
+{
+    check(Axis >= 0 && Axis < NumAxes);
+    FRecord& R = Open[Axis];
+    if (!R.bOpen)
+        return;
+    R.Times[int32(EGestureProbe::ActionStart)] = Now;
+    R.bActionStarted = true;
+}
+
+void FGestureLatencyTracker::ActionComplete(int32 Axis, double Now)
+{
+    check(Axis >= 0 && Axis < NumAxes);
+    FRecord& R = Open[Axis];
+    if (!R.bOpen || !R.bActionStarted)
+        return;
+    R.Times[int32(EGestureProbe::ActionComplete)] = Now;
+
+    auto Ms = [&R](EGestureProbe From, EGestureProbe To)
+    {
+        return float((R.Times[int32(To)] - R.Times[int32(From)]) * 1e3);
+    };
+    FLatencyHistogram* H = Stages[Axis];
+    H[OnsetToArm].Add(Ms(EGestureProbe::Onset, EGestureProbe::Arm));
+    H[ArmToFire].Add(Ms(EGestureProbe::Arm, EGestureProbe::Fire));
+    H[FireToArrival].Add(Ms(EGestureProbe::Fire, EGestureProbe::Arrival));
+    H[ArrivalToAction].Add(Ms(EGestureProbe::Arrival, EGestureProbe::ActionStart));
+    H[ActionToComplete].Add(Ms(EGestureProbe::ActionStart, EGestureProbe::ActionComplete));
+    H[OnsetToComplete].Add(Ms(EGestureProbe::Onset, EGestureProbe::ActionComplete));
+
+    R.bOpen = false;
+    ++NumCompleted;
+}
+
+void FGestureLatencyTracker::Report(const TCHAR* RunName, FOutputDevice& Ar) const
+{
+    static const TCHAR* AxisNames[NumAxes] = { TEXT("lane change"), TEXT("collect") };
+    static const TCHAR* StageNames[NumStages] =
+    {
+        TEXT("onset -> arm"), TEXT("arm -> fire"), TEXT("fire -> arrival"),
+        TEXT("arrival -> action"), TEXT("action -> complete"), TEXT("onset -> complete"),
+    };
+
+    Ar.Logf(TEXT("Gesture latency (%s): %d flicks"), RunName, NumCompleted);
+    for (int32 Axis = 0; Axis < NumAxes; ++Axis)
+    {
+        if (Stages[Axis][OnsetToComplete].Num() == 0)
+            continue;
+
+        Ar.Logf(TEXT("  %s"), AxisNames[Axis]);
+        Ar.Logf(TEXT("    %-20s %5s %8s %8s %8s %8s %8s"), TEXT("stage (ms)"), TEXT("n"), TEXT("mean"), TEXT("p50"), TEXT("p95"), TEXT("p99"), TEXT("max"));
+        for (int32 s = 0; s < NumStages; ++s)
+        {
+            const FLatencyHistogram& H = Stages[Axis][s];
+            Ar.Logf(TEXT("    %-20s %5d %8.1f %8.1f %8.1f %8.1f %8.1f"), StageNames[s], H.Num(), H.GetMeanMs(),
+                H.GetPercentileMs(0.50f), H.GetPercentileMs(0.95f), H.GetPercentileMs(0.99f), H.GetMaxMs());
+        }
+    }
+}
+
+void FGestureLatencyTracker::Reset()
+{
+    for (int32 Axis = 0; Axis < NumAxes; ++Axis)
+    {
+        Open[Axis] = FRecord();
+        for (FLatencyHistogram& H : Stages[Axis])
+            H.Reset();
+    }
+    NumCompleted = 0;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// -------- Fixed-bucket latency histogram (1 ms buckets up to 500 ms, then overflow) --------
+struct TUNNELZ_API FLatencyHistogram
+{
+    static constexpr int32 NumBuckets = 500;
+    static constexpr float BucketMs = 1.f;
+
+    void Add(float Ms);
+    void Reset();
+
+    int32 Num() const { return Count; }
+    float GetMeanMs() const { return Count > 0 ? float(SumMs / Count) : 0.f; }
+    float GetMaxMs() const { return MaxMs; }
+
+    // P in [0, 1]; interpolated within the bucket, overflow reports the max
+    float GetPercentileMs(float P) const;
+
+private:
+    uint32 Buckets[NumBuckets + 1] = {};
+    int32 Count = 0;
+    double SumMs = 0.0;
+    float MaxMs = 0.f;
+};
+
+// Probe points along one flick, all in the FPlatformTime::Seconds() timebase.
+// Onset, Arm and Fire are sensor timestamps; the rest are game-thread times.
+enum class EGestureProbe : uint8
+{
+    Onset,          // rate crossed the detector's End threshold
+    Arm,            // detector armed
+    Fire,           // detector fired (sample timestamp)
+    Arrival,        // game thread processed the firing sample
+    ActionStart,    // gameplay reacted (lane change / collect started)
+    ActionComplete, // lane blend finished
+    Num
+};
+
+// Collects per-flick probe times per axis and folds completed flicks into stage histograms
+class TUNNELZ_API FGestureLatencyTracker
+{
+public:
+    static constexpr int32 NumAxes = 2; // 0 = up (lane change), 1 = right (collect)
+
+    // A fired flick that gameplay acted on; opens the axis' record
+    void Fire(int32 Axis, double OnsetTime, double ArmTime, double FireTime, double ArrivalTime);
+    void ActionStart(int32 Axis, double Now);
+
+    // Closes the axis' record if it has started its action
+    void ActionComplete(int32 Axis, double Now);
+
+    int32 GetNumCompleted() const { return NumCompleted; }
+
+    void Report(const TCHAR* RunName, FOutputDevice& Ar) const;
+    void Reset();
+
+private:
+    enum EStage : uint8 { OnsetToArm, ArmToFire, FireToArrival, ArrivalToAction, ActionToComplete, OnsetToComplete, NumStages };
+
+    struct FRecord
+    {
+        double Times[int32(EGestureProbe::Num)] = {};
+        bool bOpen = false;
+        bool bActionStarted = false;
+    };
+
+    FRecord Open[NumAxes];
+    FLatencyHistogram Stages[NumAxes][NumStages];
+    int32 NumCompleted = 0;
+};
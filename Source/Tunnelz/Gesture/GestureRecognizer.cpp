@@ -0,0 +1,369 @@
+#include "GestureRecognizer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+    // Sums over one channel of the window W against template T
+    struct FMoments
+    {
+        float SumWT = 0.f;
+        float SumW = 0.f;
+        float SumWW = 0.f;
+    };
+
+    FMoments MomentsScalar(const float* W, const float* T, int32 Num, int32 Start = 0)
+    {
+        FMoments M;
+        for (int32 i = Start; i < Num; ++i)
+        {
+            M.SumWT += W[i] * T[i];
+            M.SumW += W[i];
+            M.SumWW += W[i] * W[i];
+        }
+        return M;
+    }
+
+    float HorizontalSum(VectorRegister4Float V)
+    {
+        alignas(16) float Lanes[4];
+        VectorStoreAligned(V, Lanes);
+        return (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+    }
+
+    FMoments MomentsSimd(const float* W, const float* T, int32 Num)
+    {
+        VectorRegister4Float WT = VectorZeroFloat();
+        VectorRegister4Float S = VectorZeroFloat();
+        VectorRegister4Float SS = VectorZeroFloat();
+
+        const int32 NumVec = Num & ~3;
+        for (int32 i = 0; i < NumVec; i += 4)
+        {
+            const VectorRegister4Float W4 = VectorLoad(W + i);
+            WT = VectorMultiplyAdd(W4, VectorLoad(T + i), WT);
+            S = VectorAdd(S, W4);
+            SS = VectorMultiplyAdd(W4, W4, SS);
+        }
+
+        FMoments M = MomentsScalar(W, T, Num, NumVec);
+        M.SumWT += HorizontalSum(WT);
+        M.SumW += HorizontalSum(S);
+        M.SumWW += HorizontalSum(SS);
+        return M;
+    }
+
+    // Linear resample of Src to NewNum samples spanning the same duration
+    TArray<float> Resample(const TArray<float>& Src, int32 NewNum)
+    {
+        TArray<float> Out;
+        Out.SetNumUninitialized(NewNum);
+        const float Step = (NewNum > 1) ? float(Src.Num() - 1) / float(NewNum - 1) : 0.f;
+        for (int32 i = 0; i < NewNum; ++i)
+        {
+            const float X = i * Step;
+            const int32 I0 = FMath::Min(int32(X), Src.Num() - 1);
+            const int32 I1 = FMath::Min(I0 + 1, Src.Num() - 1);
+            Out[i] = FMath::Lerp(Src[I0], Src[I1], X - I0);
+        }
+        return Out;
+    }
+
+    // Half-sine pulse of Peak rad/s over DurationSec, written into Channel from StartSec
+    void AddPulse(TArray<float>& Channel, float RateHz, float StartSec, float DurationSec, float Peak)
+    {
+        const int32 First = FMath::RoundToInt(StartSec * RateHz);
+        const int32 Count = FMath::Max(1, FMath::RoundToInt(DurationSec * RateHz));
+        for (int32 i = 0; i < Count && First + i < Channel.Num(); ++i)
+            Channel[First + i] += Peak * FMath::Sin(PI * (i + 0.5f) / Count);
+    }
+}
+
+// -------- Template I/O --------
+
+bool FGestureTemplate::SaveCsv(const FString& Path) const
+{
+    FString Csv = FString::Printf(TEXT("# rate_hz=%g\nup,right,twist\n"), RateHz);
+    for (int32 i = 0; i < Num(); ++i)
+        Csv += FString::Printf(TEXT("%.4f,%.4f,%.4f\n"), Channels[0][i], Channels[1][i], Channels[2][i]);
+    return FFileHelper::SaveStringToFile(Csv, *Path);
+}
+
+bool FGestureTemplate::LoadCsv(const FString& Path)
+{
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+        return false;
+
+    for (TArray<float>& C : Channels)
+        C.Reset();
+
+    for (const FString& Line : Lines)
+    {
+        if (Line.StartsWith(TEXT("#")))
+        {
+            FParse::Value(*Line, TEXT("rate_hz="), RateHz);
+            continue;
+        }
+
+        TArray<FString> Cells;
+        if (Line.ParseIntoArray(Cells, TEXT(",")) != NumChannels || !Cells[0].IsNumeric())
+            continue;
+        for (int32 c = 0; c < NumChannels; ++c)
+            Channels[c].Add(FCString::Atof(*Cells[c]));
+    }
+    return Num() >= 4 && RateHz > 0.f;
+}
+
+// -------- Recognizer --------
+
+void FGestureRecognizer::Init(const FGestureRecognizerSettings& InSettings)
+{
+    Settings = InSettings;
+    Settings.RateHz = FMath::Clamp(Settings.RateHz, 20.f, 400.f);
+    Capacity = FMath::Max(8, FMath::RoundToInt(Settings.MaxWindowSec * Settings.RateHz));
+    for (TArray<float>& C : Ring)
+        C.Init(0.f, Capacity * 2);
+    Templates.Reset();
+    Reset();
+}
+
+void FGestureRecognizer::Reset()
+{
+    for (TArray<float>& C : Ring)
+        FMemory::Memzero(C.GetData(), C.Num() * sizeof(float));
+    Head = 0;
+    NumBins = 0;
+    Cursor = 0;
+    BinEnd = -1.0;
+    BinSum = FVector3f::ZeroVector;
+    BinCount = 0;
+    LastBin = FVector3f::ZeroVector;
+    for (FEntry& E : Templates)
+        E.RefractoryUntil = 0.0;
+}
+
+int32 FGestureRecognizer::NumVariants() const
+{
+    int32 N = 0;
+    for (const FEntry& E : Templates)
+        N += E.Variants.Num();
+    return N;
+}
+
+void FGestureRecognizer::AddTemplate(const FGestureTemplate& Template)
+{
+    if (Template.Num() < 4)
+        return;
+
+    FEntry Entry;
+    Entry.Name = Template.Name;
+
+    // Template time base -> recognizer bins
+    const float BaseNum = Template.Num() * Settings.RateHz / FMath::Max(Template.RateHz, 1.f);
+    for (const float Scale : Settings.TimeScales)
+    {
+        const int32 Num = FMath::RoundToInt(BaseNum * Scale);
+        if (Num < 4 || Num > Capacity)
+            continue;
+
+        FVariant V;
+        V.Num = Num;
+        double Energy = 0.0;
+        for (int32 c = 0; c < FGestureTemplate::NumChannels; ++c)
+        {
+            V.Normalized[c] = Resample(Template.Channels[c], Num);
+            float Mean = 0.f;
+            for (const float X : V.Normalized[c]) Mean += X;
+            Mean /= Num;
+            for (float& X : V.Normalized[c])
+            {
+                X -= Mean;
+                Energy += X * X;
+            }
+        }
+        if (Energy <= 1e-6)
+            continue;
+
+        const float InvNorm = float(1.0 / FMath::Sqrt(Energy));
+        for (TArray<float>& C : V.Normalized)
+            for (float& X : C) X *= InvNorm;
+        V.Rms = float(FMath::Sqrt(Energy / (Num * FGestureTemplate::NumChannels)));
+        Entry.Variants.Add(MoveTemp(V));
+    }
+    if (Entry.Variants.IsEmpty())
+        return;
+
+    if (FEntry* Existing = Templates.FindByPredicate([&](const FEntry& E) { return E.Name == Entry.Name; }))
+        *Existing = MoveTemp(Entry);
+    else
+        Templates.Add(MoveTemp(Entry));
+}
+
+void FGestureRecognizer::WriteBin(const FVector3f& Value)
+{
+    const float Values[FGestureTemplate::NumChannels] = { Value.Z, Value.Y, Value.X };
+    for (int32 c = 0; c < FGestureTemplate::NumChannels; ++c)
+    {
+        Ring[c][Head] = Values[c];
+        Ring[c][Head + Capacity] = Values[c];
+    }
+    Head = (Head + 1) % Capacity;
+    NumBins = FMath::Min(NumBins + 1, Capacity);
+}
+
+void FGestureRecognizer::Push(double Timestamp, const FVector3f& PlayRate)
+{
+    if (Capacity == 0)
+        return;
+
+    const double BinSec = 1.0 / Settings.RateHz;
+    if (BinEnd < 0.0)
+        BinEnd = Timestamp + BinSec;
+
+    // Close every bin that ended before this sample; bins with no samples repeat the last value
+    for (int32 Closed = 0; Timestamp >= BinEnd; ++Closed)
+    {
+        if (Closed >= Capacity)
+        {
+            BinEnd = Timestamp + BinSec; // long gap, the whole window is stale anyway
+            break;
+        }
+        if (BinCount > 0)
+        {
+            LastBin = BinSum / float(BinCount);
+            BinSum = FVector3f::ZeroVector;
+            BinCount = 0;
+        }
+        WriteBin(LastBin);
+        BinEnd += BinSec;
+    }
+
+    BinSum += PlayRate;
+    ++BinCount;
+    LastTimestamp = Timestamp;
+}
+
+float FGestureRecognizer::ScoreVariant(const FVariant& V) const
+{
+    const int32 Start = Head + Capacity - V.Num;
+
+    float Dot = 0.f;
+    float CenteredEnergy = 0.f;
+    for (int32 c = 0; c < FGestureTemplate::NumChannels; ++c)
+    {
+        const float* W = Ring[c].GetData() + Start;
+        const FMoments M = bUseSimd ? MomentsSimd(W, V.Normalized[c].GetData(), V.Num) : MomentsScalar(W, V.Normalized[c].GetData(), V.Num);
+        // The template is zero-mean per channel, so the window's mean drops out of the dot product
+        Dot += M.SumWT;
+        CenteredEnergy += M.SumWW - M.SumW * M.SumW / V.Num;
+    }
+
+    const float Rms = FMath::Sqrt(FMath::Max(CenteredEnergy, 0.f) / (V.Num * FGestureTemplate::NumChannels));
+    if (Rms < Settings.MinRmsRad || Rms * Settings.AmplitudeRatioRange < V.Rms || Rms > V.Rms * Settings.AmplitudeRatioRange)
+        return -1.f;
+
+    return Dot * FMath::InvSqrt(FMath::Max(CenteredEnergy, 1e-12f));
+}
+
+void FGestureRecognizer::Evaluate(double BudgetSec, TArray<FGestureMatch>& OutMatches)
+{
+    LastNumEvaluated = 0;
+    LastNumDeferred = 0;
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    const int32 Num = Templates.Num();
+    const double Now = LastTimestamp;
+    if (Num == 0)
+        return;
+
+    FEntry* BestEntry = nullptr;
+    float BestScore = Settings.Threshold;
+    for (int32 k = 0; k < Num; ++k)
+    {
+        // Always make progress by at least one template
+        if (k > 0 && FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) >= BudgetSec)
+        {
+            LastNumDeferred = Num - k;
+            break;
+        }
+
+        FEntry& E = Templates[Cursor];
+        Cursor = (Cursor + 1) % Num;
+        ++LastNumEvaluated;
+        if (Now < E.RefractoryUntil)
+            continue;
+
+        float Score = -1.f;
+        int32 Longest = 0;
+        for (const FVariant& V : E.Variants)
+        {
+            Longest = FMath::Max(Longest, V.Num);
+            if (V.Num <= NumBins)
+                Score = FMath::Max(Score, ScoreVariant(V));
+        }
+
+        if (Score >= Settings.Threshold)
+        {
+            // Every template that matched sits out its own length; only the best one is reported
+            E.RefractoryUntil = Now + Longest / Settings.RateHz;
+            if (Score >= BestScore)
+            {
+                BestScore = Score;
+                BestEntry = &E;
+            }
+        }
+    }
+
+    if (BestEntry)
+        OutMatches.Add({ BestEntry->Name, BestScore, Now });
+    LastCostSec = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+}
+
+bool FGestureRecognizer::CaptureTemplate(FName Name, float Seconds, FGestureTemplate& OutTemplate) const
+{
+    const int32 Num = FMath::RoundToInt(Seconds * Settings.RateHz);
+    if (Num < 4 || Num > NumBins)
+        return false;
+
+    OutTemplate.Name = Name;
+    OutTemplate.RateHz = Settings.RateHz;
+    const int32 Start = Head + Capacity - Num;
+    for (int32 c = 0; c < FGestureTemplate::NumChannels; ++c)
+        OutTemplate.Channels[c] = TArray<float>(Ring[c].GetData() + Start, Num);
+    return true;
+}
+
+TArray<FGestureTemplate> FGestureRecognizer::MakeDefaultTemplates(float RateHz)
+{
+    auto Make = [RateHz](const TCHAR* Name, float Seconds)
+    {
+        FGestureTemplate T;
+        T.Name = Name;
+        T.RateHz = RateHz;
+        for (TArray<float>& C : T.Channels)
+            C.Init(0.f, FMath::RoundToInt(Seconds * RateHz));
+        return T;
+    };
+
+    TArray<FGestureTemplate> Out;
+
+    FGestureTemplate& DoubleUp = Out.Add_GetRef(Make(TEXT("DoubleFlickUp"), 0.42f));
+    AddPulse(DoubleUp.Channels[0], RateHz, 0.02f, 0.12f, 4.f);
+    AddPulse(DoubleUp.Channels[0], RateHz, 0.24f, 0.12f, 4.f);
+
+    FGestureTemplate& DoubleRight = Out.Add_GetRef(Make(TEXT("DoubleFlickRight"), 0.42f));
+    AddPulse(DoubleRight.Channels[1], RateHz, 0.02f, 0.12f, 4.f);
+    AddPulse(DoubleRight.Channels[1], RateHz, 0.24f, 0.12f, 4.f);
+
+    // Wrist roll one way and straight back
+    FGestureTemplate& Twist = Out.Add_GetRef(Make(TEXT("Twist"), 0.4f));
+    AddPulse(Twist.Channels[2], RateHz, 0.02f, 0.16f, 5.f);
+    AddPulse(Twist.Channels[2], RateHz, 0.2f, 0.16f, -5.f);
+
+    // Up flick, held still, then swung back; a held flick looks like any other until the release
+    FGestureTemplate& FlickHold = Out.Add_GetRef(Make(TEXT("FlickAndHold"), 0.72f));
+    AddPulse(FlickHold.Channels[0], RateHz, 0.02f, 0.12f, 4.f);
+    AddPulse(FlickHold.Channels[0], RateHz, 0.52f, 0.16f, -3.f);
+
+    return Out;
+}
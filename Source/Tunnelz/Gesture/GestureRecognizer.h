@@ -0,0 +1,113 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Template-matching recognizer for multi-stage gestures (double flicks, twists, flick-and-hold).
+// Play-frame rates are box-averaged into fixed-rate bins and kept in a rolling window; each frame,
+// every template is scored against the newest slice of the window by normalized cross-correlation
+// (4-wide SIMD, three channels: up, right, twist). Scoring stops when the per-frame budget runs
+// out and resumes with the next template on the following frame.
+// Runs alongside the flick detectors: it doesn't suppress single flicks that are part of a match.
+
+// One gesture shape, sampled at the recognizer rate. Channels: 0 = up, 1 = right, 2 = twist.
+struct TUNNELZ_API FGestureTemplate
+{
+    static constexpr int32 NumChannels = 3;
+
+    FName Name;
+    float RateHz = 100.f;
+    TArray<float> Channels[NumChannels];
+
+    int32 Num() const { return Channels[0].Num(); }
+
+    // Plain CSV: "# rate_hz=100" then "up,right,twist" rows
+    bool SaveCsv(const FString& Path) const;
+    bool LoadCsv(const FString& Path);
+};
+
+struct FGestureMatch
+{
+    FName Name;
+    float Score = 0.f; // normalized correlation, -1..1
+    double Time = 0.0; // timestamp of the newest sample in the matched window
+};
+
+struct FGestureRecognizerSettings
+{
+    float RateHz = 100.f;
+    float MaxWindowSec = 1.28f;
+    float Threshold = 0.82f;
+    float MinRmsRad = 0.3f;            // quieter windows never match, whatever their shape
+    float AmplitudeRatioRange = 3.f;   // window RMS must be within [1/x, x] of the template's
+    TArray<float> TimeScales = { 0.8f, 1.f, 1.25f }; // tolerated speed variation
+};
+
+class TUNNELZ_API FGestureRecognizer
+{
+public:
+    void Init(const FGestureRecognizerSettings& InSettings);
+    void Reset();
+
+    // Adds (or replaces, by name) a template; time-scaled variants are built here
+    void AddTemplate(const FGestureTemplate& Template);
+    int32 NumTemplates() const { return Templates.Num(); }
+    int32 NumVariants() const;
+
+    // Play-frame rate (X = twist, Y = right, Z = up), FPlatformTime::Seconds() timebase
+    void Push(double Timestamp, const FVector3f& PlayRate);
+
+    // Scores templates until the budget is spent; appends matches. Call once per frame.
+    void Evaluate(double BudgetSec, TArray<FGestureMatch>& OutMatches);
+
+    // Copies the newest Seconds of the window into a template; Seconds can't exceed GetWindowSec()
+    bool CaptureTemplate(FName Name, float Seconds, FGestureTemplate& OutTemplate) const;
+
+    // Length of the motion history kept (MaxWindowSec, in whole bins); 0 before Init
+    float GetWindowSec() const { return Settings.RateHz > 0.f ? Capacity / Settings.RateHz : 0.f; }
+
+    // Forces the scalar kernel (benchmark comparison)
+    bool bUseSimd = true;
+
+    // Last Evaluate call
+    int32 LastNumEvaluated = 0;
+    int32 LastNumDeferred = 0;
+    double LastCostSec = 0.0;
+
+    // Built-in shapes used when no recorded template overrides them
+    static TArray<FGestureTemplate> MakeDefaultTemplates(float RateHz);
+
+private:
+    struct FVariant
+    {
+        int32 Num = 0;
+        TArray<float> Normalized[FGestureTemplate::NumChannels]; // zero mean per channel, unit joint norm
+        float Rms = 0.f;
+    };
+
+    struct FEntry
+    {
+        FName Name;
+        TArray<FVariant> Variants;
+        double RefractoryUntil = 0.0;
+    };
+
+    float ScoreVariant(const FVariant& V) const;
+    void WriteBin(const FVector3f& Value);
+
+    FGestureRecognizerSettings Settings;
+    TArray<FEntry> Templates;
+    int32 Cursor = 0; // next template to score when the budget ran out
+
+    // Doubled ring per channel so the newest N bins are always contiguous
+    int32 Capacity = 0;
+    int32 Head = 0;
+    int32 NumBins = 0;
+    TArray<float> Ring[FGestureTemplate::NumChannels];
+
+    // Box-average accumulator for the bin being filled
+    double BinEnd = -1.0;
+    double LastTimestamp = 0.0;
+    FVector3f BinSum = FVector3f::ZeroVector;
+    int32 BinCount = 0;
+    FVector3f LastBin = FVector3f::ZeroVector;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// One timestamped motion sample, in the same device frame and units as
+// APlayerController::GetInputMotionState (rotation rate in rad/s).
+struct FImuSample
+{
+    double   Timestamp = 0.0; // FPlatformTime::Seconds() timebase
+    FVector3f RotationRate = FVector3f::ZeroVector;
+    FVector3f Gravity = FVector3f::ZeroVector;
+    FVector3f Accel = FVector3f::ZeroVector;
+    FVector3f Tilt = FVector3f::ZeroVector;
+};
@@ -0,0 +1,128 @@
+#include "ImuSampler.h"
+#include "HAL/RunnableThread.h"
+
+#if PLATFORM_ANDROID
+#include <android/looper.h>
+#include <android/sensor.h>
+#include <time.h>
+#endif
+
+FImuSampler::FImuSampler(float InRateHz)
+    : RateHz(FMath::Clamp(InRateHz, 50.f, 500.f))
+{
+}
+
+FImuSampler::~FImuSampler()
+{
+    Shutdown();
+}
+
+bool FImuSampler::Start()
+{
+#if PLATFORM_ANDROID
+    if (Thread)
+        return true;
+
+    // Decide up front so the ring never has two producers
+    if (!ASensorManager_getDefaultSensor(ASensorManager_getInstance(), ASENSOR_TYPE_GYROSCOPE))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("IMU sampler: no gyroscope, staying on per-frame motion input."));
+        return false;
+    }
+
+    bStopRequested = false;
+    Thread = FRunnableThread::Create(this, TEXT("TunnelzImuSampler"), 64 * 1024, TPri_AboveNormal);
+    return Thread != nullptr;
+#else
+    return false;
+#endif
+}
+
+void FImuSampler::Shutdown()
+{
+    if (Thread)
+    {
+        Thread->Kill(true); // calls Stop() and joins
+        delete Thread;
+        Thread = nullptr;
+    }
+}
+
+uint32 FImuSampler::Run()
+{
+#if PLATFORM_ANDROID
+    constexpr int LooperId = 1;
+
+    ALooper* Looper = ALooper_prepare(ALOOPER_PREPARE_ALLOW_NON_CALLBACKS);
+    ASensorManager* Manager = ASensorManager_getInstance();
+    const ASensor* Gyro = ASensorManager_getDefaultSensor(Manager, ASENSOR_TYPE_GYROSCOPE);
+    const ASensor* Accelerometer = ASensorManager_getDefaultSensor(Manager, ASENSOR_TYPE_ACCELEROMETER);
+    const ASensor* GravitySensor = ASensorManager_getDefaultSensor(Manager, ASENSOR_TYPE_GRAVITY);
+    if (!Gyro)
+        return 1;
+
+    ASensorEventQueue* Queue = ASensorManager_createEventQueue(Manager, Looper, LooperId, nullptr, nullptr);
+    // Android 12+ caps requests at 200 Hz unless HIGH_SAMPLING_RATE_SENSORS is granted
+    const int32 PeriodUs = FMath::RoundToInt(1e6f / RateHz);
+    for (const ASensor* Sensor : { Gyro, Accelerometer, GravitySensor })
+    {
+        if (Sensor)
+        {
+            ASensorEventQueue_enableSensor(Queue, Sensor);
+            ASensorEventQueue_setEventRate(Queue, Sensor, FMath::Max(PeriodUs, ASensor_getMinDelay(Sensor)));
+        }
+    }
+
+    // Android reports m/s^2, the engine reports gravity/accel in g
+    constexpr float InvG = 1.f / 9.80665f;
+    FVector3f LatestAccel = FVector3f::ZeroVector;
+    FVector3f LatestGravity = FVector3f::ZeroVector;
+
+    ASensorEvent Events[32];
+    while (!bStopRequested)
+    {
+        ALooper_pollOnce(50, nullptr, nullptr, nullptr);
+
+        // Sensor timestamps are CLOCK_BOOTTIME ns; rebase them onto FPlatformTime::Seconds()
+        timespec Now;
+        clock_gettime(CLOCK_BOOTTIME, &Now);
+        const int64 BootNowNs = int64(Now.tv_sec) * 1000000000ll + Now.tv_nsec;
+        const double PlatformNow = FPlatformTime::Seconds();
+
+        ssize_t NumEvents = 0;
+        while ((NumEvents = ASensorEventQueue_getEvents(Queue, Events, UE_ARRAY_COUNT(Events))) > 0)
+        {
+            for (ssize_t i = 0; i < NumEvents; ++i)
+            {
+                const ASensorEvent& E = Events[i];
+                const FVector3f V(E.data[0], E.data[1], E.data[2]);
+                switch (E.type)
+                {
+                case ASENSOR_TYPE_ACCELEROMETER: LatestAccel = V * InvG; break;
+                case ASENSOR_TYPE_GRAVITY:       LatestGravity = V * InvG; break;
+                case ASENSOR_TYPE_GYROSCOPE:
+                {
+                    // NDK device axes, rad/s, same frame the engine forwards to GetInputMotionState
+                    FImuSample S;
+                    S.Timestamp = PlatformNow - double(BootNowNs - E.timestamp) * 1e-9;
+                    S.RotationRate = V;
+                    S.Accel = LatestAccel;
+                    S.Gravity = LatestGravity;
+                    Ring.Push(S);
+                    break;
+                }
+                default: break;
+                }
+            }
+        }
+    }
+
+    for (const ASensor* Sensor : { Gyro, Accelerometer, GravitySensor })
+    {
+        if (Sensor)
+            ASensorEventQueue_disableSensor(Queue, Sensor);
+    }
+    ASensorManager_destroyEventQueue(Manager, Queue);
+#endif
+    return 0;
+}
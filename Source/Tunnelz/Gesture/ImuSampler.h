@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "ImuSample.h"
+#include "SpscRingBuffer.h"
+
+class FRunnableThread;
+
+// Reads the gyro at sensor rate on its own thread and queues timestamped samples for the
+// game thread. Where no native sensor path exists (or it fails to start), the owner keeps
+// producing into the same ring once per frame via PushFromGameThread.
+class TUNNELZ_API FImuSampler : public FRunnable
+{
+public:
+    using FRing = TSpscRingBuffer<FImuSample, 1024>;
+
+    explicit FImuSampler(float InRateHz);
+    virtual ~FImuSampler();
+
+    // Spawns the sampling thread; false if this platform has no native sensor path
+    bool Start();
+    void Shutdown();
+
+    bool IsRunning() const { return Thread != nullptr; }
+    float GetRateHz() const { return RateHz; }
+
+    // Only valid while !IsRunning(), so the ring keeps a single producer
+    void PushFromGameThread(const FImuSample& Sample)
+    {
+        check(!IsRunning());
+        Ring.Push(Sample);
+    }
+
+    FRing& GetRing() { return Ring; }
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override { bStopRequested = true; }
+
+private:
+    float RateHz = 250.f;
+    FRing Ring;
+    FRunnableThread* Thread = nullptr;
+    std::atomic<bool> bStopRequested{ false };
+};
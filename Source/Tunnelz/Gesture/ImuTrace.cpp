@@ -0,0 +1,242 @@
+#include "ImuTrace.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include "FlickPipeline.h"
+
+namespace
+{
+    constexpr int32 FlushEveryRecords = 256;
+
+    void ToFloats(const FVector3f& V, float Out[3])
+    {
+        Out[0] = V.X;
+        Out[1] = V.Y;
+        Out[2] = V.Z;
+    }
+
+    FVector3f FromFloats(const float In[3])
+    {
+        return FVector3f(In[0], In[1], In[2]);
+    }
+}
+
+// -------- Writer --------
+
+FImuTraceWriter::FImuTraceWriter() = default;
+
+FImuTraceWriter::~FImuTraceWriter()
+{
+    Close();
+}
+
+FString FImuTraceWriter::MakeDefaultPath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("ImuTraces") / FString::Printf(TEXT("Trace_%s.tzimu"), *FDateTime::Now().ToString());
+}
+
+bool FImuTraceWriter::Open(const FString& InPath, float NominalRateHz)
+{
+    Close();
+
+    IPlatformFile& PF = FPlatformFileManager::Get().GetPlatformFile();
+    PF.CreateDirectoryTree(*FPaths::GetPath(InPath));
+    File.Reset(PF.OpenWrite(*InPath));
+    if (!File)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("IMU trace: cannot open %s for writing"), *InPath);
+        return false;
+    }
+
+    // StartTime is patched in by the first Append
+    FImuTraceHeader Header;
+    Header.RecordSize = sizeof(FImuTraceRecord);
+    Header.NominalRateHz = NominalRateHz;
+    File->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+
+    Path = InPath;
+    StartTime = -1.0;
+    NumRecords = 0;
+    Pending.Reset(FlushEveryRecords);
+    return true;
+}
+
+void FImuTraceWriter::Append(const FImuSample& Sample)
+{
+    if (!File)
+        return;
+
+    if (StartTime < 0.0)
+    {
+        StartTime = Sample.Timestamp;
+        const int64 Pos = File->Tell();
+        File->Seek(STRUCT_OFFSET(FImuTraceHeader, StartTime));
+        File->Write(reinterpret_cast<const uint8*>(&StartTime), sizeof(StartTime));
+        File->Seek(Pos);
+    }
+
+    FImuTraceRecord& R = Pending.AddDefaulted_GetRef();
+    R.TimeUs = uint32(FMath::Max(0.0, Sample.Timestamp - StartTime) * 1e6);
+    ToFloats(Sample.RotationRate, R.RotationRate);
+    ToFloats(Sample.Gravity, R.Gravity);
+    ToFloats(Sample.Accel, R.Accel);
+    ToFloats(Sample.Tilt, R.Tilt);
+
+    if (Pending.Num() >= FlushEveryRecords)
+        Flush();
+}
+
+void FImuTraceWriter::Flush()
+{
+    if (File && Pending.Num() > 0)
+    {
+        File->Write(reinterpret_cast<const uint8*>(Pending.GetData()), Pending.Num() * sizeof(FImuTraceRecord));
+        NumRecords += Pending.Num();
+        Pending.Reset();
+    }
+}
+
+void FImuTraceWriter::Close()
+{
+    if (File)
+    {
+        Flush();
+        File.Reset();
+        UE_LOG(LogTemp, Log, TEXT("IMU trace: wrote %lld samples to %s"), NumRecords, *Path);
+    }
+}
+
+// -------- Memory-mapped view --------
+
+FImuTraceView::FImuTraceView() = default;
+
+FImuTraceView::~FImuTraceView()
+{
+    Close();
+}
+
+bool FImuTraceView::Open(const FString& Path)
+{
+    Close();
+
+    FOpenMappedResult Result = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*Path);
+    if (Result.HasError())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("IMU trace: cannot map %s"), *Path);
+        return false;
+    }
+
+    Handle = Result.StealValue();
+    const int64 Size = Handle->GetFileSize();
+    if (Size < int64(sizeof(FImuTraceHeader)))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("IMU trace: %s is too small"), *Path);
+        Close();
+        return false;
+    }
+
+    Region.Reset(Handle->MapRegion(0, Size));
+    if (!Region)
+    {
+        Close();
+        return false;
+    }
+
+    const uint8* Data = Region->GetMappedPtr();
+    FMemory::Memcpy(&Header, Data, sizeof(Header));
+    if (Header.Magic != FImuTraceHeader::MagicValue || Header.Version != FImuTraceHeader::CurrentVersion
+        || Header.RecordSize != sizeof(FImuTraceRecord))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("IMU trace: %s has an unsupported header"), *Path);
+        Close();
+        return false;
+    }
+
+    const int64 NumRecords = (Size - int64(sizeof(FImuTraceHeader))) / int64(sizeof(FImuTraceRecord));
+    Records = MakeArrayView(reinterpret_cast<const FImuTraceRecord*>(Data + sizeof(FImuTraceHeader)), int32(NumRecords));
+    return true;
+}
+
+void FImuTraceView::Close()
+{
+    Records = TConstArrayView<FImuTraceRecord>();
+    Region.Reset();
+    Handle.Reset();
+}
+
+FImuSample FImuTraceView::ToSample(const FImuTraceRecord& Record)
+{
+    FImuSample S;
+    S.Timestamp = Record.TimeUs * 1e-6;
+    S.RotationRate = FromFloats(Record.RotationRate);
+    S.Gravity = FromFloats(Record.Gravity);
+    S.Accel = FromFloats(Record.Accel);
+    S.Tilt = FromFloats(Record.Tilt);
+    return S;
+}
+
+// -------- Replay --------
+
+FImuReplayStats ImuTrace::Replay(const FImuTraceView& Trace, FFlickPipeline& Pipeline, TArray<FFlickEvent>& OutEvents)
+{
+    const float NominalDt = 1.f / FMath::Max(1.f, Trace.GetHeader().NominalRateHz);
+
+    FImuReplayStats Stats;
+    Stats.NumSamples = Trace.Num();
+    Stats.TraceSeconds = Trace.GetDurationSec();
+
+    Pipeline.ResetClock();
+    const double Start = FPlatformTime::Seconds();
+    for (const FImuTraceRecord& Record : Trace.GetRecords())
+    {
+        const FImuSample Sample = FImuTraceView::ToSample(Record);
+        const FFlickPipelineResult R = Pipeline.Process(Sample, NominalDt);
+        if (R.UpFlick != 0)
+            OutEvents.Add({ Sample.Timestamp, 0, int8(R.UpFlick), Pipeline.UpChan.Detector.LastOnsetToFireSec });
+        if (R.RightFlick != 0)
+            OutEvents.Add({ Sample.Timestamp, 1, int8(R.RightFlick), Pipeline.RightChan.Detector.LastOnsetToFireSec });
+    }
+    Stats.WallSeconds = FPlatformTime::Seconds() - Start;
+    return Stats;
+}
+
+bool ImuTrace::SaveEventsCsv(const FString& Path, TConstArrayView<FFlickEvent> Events)
+{
+    FString Csv = TEXT("time_s,axis,dir,latency_ms\n");
+    for (const FFlickEvent& E : Events)
+    {
+        Csv += FString::Printf(TEXT("%.6f,%s,%d,%.1f\n"), E.Time, E.Axis == 0 ? TEXT("up") : TEXT("right"), E.Dir, E.OnsetToFireSec * 1e3f);
+    }
+    return FFileHelper::SaveStringToFile(Csv, *Path);
+}
+
+bool ImuTrace::ReplayFile(const FString& TracePath, const FFlickPipeline& Config, const FString& EventsCsvPath, FOutputDevice& Ar)
+{
+    FImuTraceView Trace;
+    if (!Trace.Open(TracePath))
+    {
+        Ar.Logf(TEXT("Replay: cannot open %s"), *TracePath);
+        return false;
+    }
+
+    FFlickPipeline Pipeline = Config;
+    TArray<FFlickEvent> Events;
+    const FImuReplayStats Stats = Replay(Trace, Pipeline, Events);
+
+    for (const FFlickEvent& E : Events)
+    {
+        Ar.Logf(TEXT("  %9.4fs  %-5s %+d  onset->fire %.1fms"), E.Time, E.Axis == 0 ? TEXT("up") : TEXT("right"), E.Dir, E.OnsetToFireSec * 1e3f);
+    }
+    Ar.Logf(TEXT("Replay %s: %d samples, %.1fs of motion, %d flicks in %.2f ms (%.1f Msamples/s, %.0fx realtime)"),
+        *FPaths::GetCleanFilename(TracePath), Stats.NumSamples, Stats.TraceSeconds, Events.Num(),
+        Stats.WallSeconds * 1e3, Stats.SamplesPerSec() / 1e6, Stats.RealtimeFactor());
+
+    if (!EventsCsvPath.IsEmpty() && !SaveEventsCsv(EventsCsvPath, Events))
+    {
+        Ar.Logf(TEXT("Replay: cannot write %s"), *EventsCsvPath);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ImuSample.h"
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+struct FFlickPipeline;
+
+// -------- On-disk trace format (.tzimu, little-endian) --------
+// Header followed by fixed-size records. The sample count is implied by the file size so a
+// trace cut short by a crash is still readable up to its last whole record.
+struct FImuTraceHeader
+{
+    static constexpr uint32 MagicValue = 0x4D495A54; // "TZIM"
+    static constexpr uint16 CurrentVersion = 1;
+
+    uint32 Magic = MagicValue;
+    uint16 Version = CurrentVersion;
+    uint16 RecordSize = 0;
+    float  NominalRateHz = 0.f;
+    uint32 Reserved = 0;
+    double StartTime = 0.0; // FPlatformTime::Seconds() of the first sample
+};
+static_assert(sizeof(FImuTraceHeader) == 24, "Trace header layout is part of the file format");
+
+struct FImuTraceRecord
+{
+    uint32 TimeUs = 0; // since StartTime
+    float RotationRate[3];
+    float Gravity[3];
+    float Accel[3];
+    float Tilt[3];
+};
+static_assert(sizeof(FImuTraceRecord) == 52, "Trace record layout is part of the file format");
+
+struct FFlickEvent
+{
+    double Time = 0.0; // seconds since trace start
+    uint8 Axis = 0;    // 0 = up (lane swap), 1 = right (collect)
+    int8 Dir = 0;      // -1 / +1
+    float OnsetToFireSec = 0.f; // detector-measured latency
+};
+
+// Buffered, append-only trace writer
+class TUNNELZ_API FImuTraceWriter
+{
+public:
+    FImuTraceWriter();
+    ~FImuTraceWriter();
+
+    bool Open(const FString& InPath, float NominalRateHz);
+    void Append(const FImuSample& Sample);
+    void Flush();
+    void Close();
+
+    bool IsOpen() const { return File.IsValid(); }
+    const FString& GetPath() const { return Path; }
+    int64 GetNumRecords() const { return NumRecords; }
+
+    // Saved/ImuTraces/Trace_<timestamp>.tzimu
+    static FString MakeDefaultPath();
+
+private:
+    TUniquePtr<IFileHandle> File;
+    FString Path;
+    double StartTime = -1.0;
+    TArray<FImuTraceRecord> Pending;
+    int64 NumRecords = 0;
+};
+
+// Read-only, memory-mapped view of a trace
+class TUNNELZ_API FImuTraceView
+{
+public:
+    FImuTraceView();
+    ~FImuTraceView();
+
+    bool Open(const FString& Path);
+    void Close();
+
+    const FImuTraceHeader& GetHeader() const { return Header; }
+    TConstArrayView<FImuTraceRecord> GetRecords() const { return Records; }
+    int32 Num() const { return Records.Num(); }
+    double GetDurationSec() const { return Records.Num() > 0 ? Records.Last().TimeUs * 1e-6 : 0.0; }
+
+    // Timestamp is relative to the trace start
+    static FImuSample ToSample(const FImuTraceRecord& Record);
+
+private:
+    TUniquePtr<IMappedFileHandle> Handle;
+    TUniquePtr<IMappedFileRegion> Region;
+    FImuTraceHeader Header;
+    TConstArrayView<FImuTraceRecord> Records;
+};
+
+struct FImuReplayStats
+{
+    int32 NumSamples = 0;
+    double TraceSeconds = 0.0;
+    double WallSeconds = 0.0;
+
+    double SamplesPerSec() const { return WallSeconds > 0.0 ? NumSamples / WallSeconds : 0.0; }
+    double RealtimeFactor() const { return WallSeconds > 0.0 ? TraceSeconds / WallSeconds : 0.0; }
+};
+
+namespace ImuTrace
+{
+    // Streams every record through Pipeline as fast as possible and collects its flicks
+    TUNNELZ_API FImuReplayStats Replay(const FImuTraceView& Trace, FFlickPipeline& Pipeline, TArray<FFlickEvent>& OutEvents);
+
+    // time_s,axis,dir,latency_ms
+    TUNNELZ_API bool SaveEventsCsv(const FString& Path, TConstArrayView<FFlickEvent> Events);
+
+    // Replays one trace through a copy of Config, logs events and throughput; optional CSV output
+    TUNNELZ_API bool ReplayFile(const FString& TracePath, const FFlickPipeline& Config, const FString& EventsCsvPath, FOutputDevice& Ar);
+}
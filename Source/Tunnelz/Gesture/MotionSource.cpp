@@ -0,0 +1,150 @@
+#include "MotionSource.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    // Catching up after a hitch is capped so a long stall can't flood the ring
+    constexpr double MaxCatchUpSec = 0.25;
+}
+
+// -------- Synthetic --------
+
+FSyntheticMotionSource::FSyntheticMotionSource(const FSyntheticMotionSettings& InSettings)
+    : Settings(InSettings)
+    , Rng(InSettings.Seed)
+{
+    Settings.RateHz = FMath::Clamp(Settings.RateHz, 10.f, 1000.f);
+    Settings.PulseSec = FMath::Max(Settings.PulseSec, 0.01f);
+    Settings.PeriodSec = FMath::Max(Settings.PeriodSec, Settings.PulseSec);
+}
+
+FVector3f FSyntheticMotionSource::Evaluate(double T) const
+{
+    const int64 Pulse = FMath::FloorToInt64(T / Settings.PeriodSec);
+    const double Phase = (T - Pulse * double(Settings.PeriodSec)) / Settings.PulseSec;
+    const float Rate = (Phase < 1.0) ? Settings.PeakRad * float(FMath::Sin(PI * Phase)) : 0.f;
+
+    const bool bUp = Settings.Axis == FSyntheticMotionSettings::EAxis::Up
+        || (Settings.Axis == FSyntheticMotionSettings::EAxis::Alternate && (Pulse & 1) == 0);
+
+    // Same device axes the pipeline reads: Z = up, Y = right
+    return bUp ? FVector3f(0.f, 0.f, Rate) : FVector3f(0.f, Rate, 0.f);
+}
+
+void FSyntheticMotionSource::Poll(double Now, TArray<FImuSample>& OutSamples)
+{
+    const double Interval = 1.0 / Settings.RateHz;
+    if (StartTime < 0.0)
+    {
+        StartTime = Now;
+        NextTime = Now;
+    }
+    NextTime = FMath::Max(NextTime, Now - MaxCatchUpSec);
+
+    for (; NextTime <= Now; NextTime += Interval)
+    {
+        FImuSample& S = OutSamples.AddDefaulted_GetRef();
+        S.Timestamp = NextTime;
+        S.RotationRate = Evaluate(NextTime - StartTime);
+        S.RotationRate.Y += Rng.FRandRange(-Settings.NoiseRad, Settings.NoiseRad);
+        S.RotationRate.Z += Rng.FRandRange(-Settings.NoiseRad, Settings.NoiseRad);
+    }
+}
+
+// -------- Trace --------
+
+bool FTraceMotionSource::Open(const FString& Path, bool bInLoop)
+{
+    bLoop = bInLoop;
+    StartTime = -1.0;
+    NextRecord = 0;
+    return Trace.Open(Path) && Trace.Num() > 0;
+}
+
+void FTraceMotionSource::Poll(double Now, TArray<FImuSample>& OutSamples)
+{
+    const TConstArrayView<FImuTraceRecord> Records = Trace.GetRecords();
+    if (Records.IsEmpty())
+        return;
+
+    if (StartTime < 0.0)
+        StartTime = Now;
+
+    while (true)
+    {
+        if (NextRecord >= Records.Num())
+        {
+            if (!bLoop)
+                return;
+
+            // Restart one nominal interval after the last record
+            StartTime += Trace.GetDurationSec() + 1.0 / FMath::Max(1.f, Trace.GetHeader().NominalRateHz);
+            NextRecord = 0;
+        }
+
+        FImuSample S = FImuTraceView::ToSample(Records[NextRecord]);
+        S.Timestamp += StartTime;
+        if (S.Timestamp > Now)
+            return;
+
+        if (S.Timestamp >= Now - MaxCatchUpSec)
+            OutSamples.Add(S);
+        ++NextRecord;
+    }
+}
+
+// -------- Factory --------
+
+TUniquePtr<IMotionSource> MotionSource::Create(const FString& Spec, float RateHz)
+{
+    const FString Trimmed = Spec.TrimStartAndEnd();
+    FString Kind = Trimmed, Args;
+    Trimmed.Split(TEXT(" "), &Kind, &Args);
+
+    if (Kind.IsEmpty() || Kind.Equals(TEXT("Device"), ESearchCase::IgnoreCase))
+        return nullptr;
+
+    if (Kind.Equals(TEXT("Synthetic"), ESearchCase::IgnoreCase))
+    {
+        FSyntheticMotionSettings Settings;
+        Settings.RateHz = RateHz;
+
+        FString Axis;
+        if (FParse::Value(*Args, TEXT("Axis="), Axis))
+        {
+            if (Axis.Equals(TEXT("Right"), ESearchCase::IgnoreCase))
+                Settings.Axis = FSyntheticMotionSettings::EAxis::Right;
+            else if (Axis.Equals(TEXT("Alternate"), ESearchCase::IgnoreCase))
+                Settings.Axis = FSyntheticMotionSettings::EAxis::Alternate;
+        }
+        FParse::Value(*Args, TEXT("Rate="), Settings.RateHz);
+        FParse::Value(*Args, TEXT("Peak="), Settings.PeakRad);
+        FParse::Value(*Args, TEXT("Pulse="), Settings.PulseSec);
+        FParse::Value(*Args, TEXT("Period="), Settings.PeriodSec);
+        FParse::Value(*Args, TEXT("Noise="), Settings.NoiseRad);
+        FParse::Value(*Args, TEXT("Seed="), Settings.Seed);
+        return MakeUnique<FSyntheticMotionSource>(Settings);
+    }
+
+    if (Kind.Equals(TEXT("Trace"), ESearchCase::IgnoreCase))
+    {
+        FString File;
+        bool bLoop = true;
+        FParse::Value(*Args, TEXT("File="), File);
+        FParse::Bool(*Args, TEXT("Loop="), bLoop);
+        if (FPaths::IsRelative(File))
+            File = FPaths::ProjectDir() / File;
+
+        TUniquePtr<FTraceMotionSource> Source = MakeUnique<FTraceMotionSource>();
+        if (!Source->Open(File, bLoop))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Motion source: cannot open trace %s"), *File);
+            return nullptr;
+        }
+        return Source;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("Motion source: unknown spec '%s'"), *Spec);
+    return nullptr;
+}
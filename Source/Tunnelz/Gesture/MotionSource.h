@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "ImuSample.h"
+#include "ImuTrace.h"
+
+// Where the game-thread motion input comes from when the sensor thread isn't running.
+// The device implementation wraps APlayerController::GetInputMotionState and lives with the
+// pawn; the synthetic and trace-backed ones below let motion be injected anywhere, editor included.
+class IMotionSource
+{
+public:
+    virtual ~IMotionSource() = default;
+
+    virtual const TCHAR* GetName() const = 0;
+
+    // Appends every sample due up to Now (FPlatformTime::Seconds() timebase)
+    virtual void Poll(double Now, TArray<FImuSample>& OutSamples) = 0;
+};
+
+// -------- Periodic half-sine flick train with optional noise --------
+struct FSyntheticMotionSettings
+{
+    enum class EAxis : uint8 { Up, Right, Alternate };
+
+    float RateHz = 250.f;
+    EAxis Axis = EAxis::Up;
+    float PeakRad = 5.f;    // signed, rad/s
+    float PulseSec = 0.12f;
+    float PeriodSec = 1.5f;
+    float NoiseRad = 0.05f; // uniform +-, rad/s
+    int32 Seed = 1234;
+};
+
+class TUNNELZ_API FSyntheticMotionSource : public IMotionSource
+{
+public:
+    explicit FSyntheticMotionSource(const FSyntheticMotionSettings& InSettings);
+
+    virtual const TCHAR* GetName() const override { return TEXT("Synthetic"); }
+    virtual void Poll(double Now, TArray<FImuSample>& OutSamples) override;
+
+    // Motion value at T seconds after the first poll, without noise
+    FVector3f Evaluate(double T) const;
+
+private:
+    FSyntheticMotionSettings Settings;
+    FRandomStream Rng;
+    double StartTime = -1.0;
+    double NextTime = 0.0;
+};
+
+// -------- Plays a recorded .tzimu trace in real time --------
+class TUNNELZ_API FTraceMotionSource : public IMotionSource
+{
+public:
+    bool Open(const FString& Path, bool bInLoop);
+
+    virtual const TCHAR* GetName() const override { return TEXT("Trace"); }
+    virtual void Poll(double Now, TArray<FImuSample>& OutSamples) override;
+
+private:
+    FImuTraceView Trace;
+    bool bLoop = true;
+    double StartTime = -1.0;
+    int32 NextRecord = 0;
+};
+
+namespace MotionSource
+{
+    // Builds a source from a spec such as
+    //     "Synthetic Axis=Up|Right|Alternate Peak=5 Pulse=0.12 Period=1.5 Noise=0.05"
+    //     "Trace File=Saved/ImuTraces/Foo.tzimu Loop=1"
+    // Empty or "Device" returns null, meaning the platform's own motion input.
+    TUNNELZ_API TUniquePtr<IMotionSource> Create(const FString& Spec, float RateHz);
+}
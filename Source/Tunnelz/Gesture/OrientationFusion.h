@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FilterStages.h"
+#include "ImuSample.h"
+
+// -------- Gravity-tracking complementary filter + gravity-aligned play frame --------
+// Tracks world "up" in device coordinates: the gyro rotates the estimate every sample and the
+// gravity (or accelerometer) reading pulls it back with time constant TauAccel, ignoring readings
+// that are far from 1 g (i.e. during the flick itself). The angular velocity is then re-expressed
+// in a play frame whose right-flick axis is world vertical and whose up-flick axis is the device's
+// up axis laid flat, so a tilted grip doesn't leak one flick axis into the other.
+// Heading isn't observable without a magnetometer and isn't needed: the frame follows the device.
+// Without any gravity reading (editor, synthetic input) the output is the raw device-frame rate.
+struct FOrientationFusion
+{
+    // Tunables
+    float TauAccel = 0.5f;        // sec
+    float AccelTrustBand = 0.15f; // g; readings outside 1 +- band don't correct
+    float PlayFrameBlend = 1.f;   // 0 = device axes, 1 = fully gravity-aligned
+
+    // Android's gravity and accelerometer report the reaction to gravity (+Y in the portrait grip),
+    // Core Motion reports gravity itself (-Y). Fixed per platform: the grip can't tell the two apart
+    // when the device is held flat.
+#if PLATFORM_IOS
+    float ReadingSign = -1.f;
+#else
+    float ReadingSign = 1.f;
+#endif
+
+    // State
+    FVector3f Up = FVector3f(0.f, 1.f, 0.f); // world up in device coordinates
+    bool bHasUp = false;
+
+    void Reset()
+    {
+        Up = FVector3f(0.f, 1.f, 0.f);
+        bHasUp = false;
+    }
+
+    // Angular velocity in the play frame, same axis convention as the device input
+    // (Z = up flick, Y = right flick); X is the remaining horizontal axis.
+    FVector3f Step(const FImuSample& S, float dt)
+    {
+        const FVector3f& W = S.RotationRate;
+
+        // Prefer the OS-fused gravity, fall back to the raw accelerometer
+        const FVector3f& Reading = S.Gravity.IsNearlyZero() ? S.Accel : S.Gravity;
+        const float ReadingG = Reading.Size();
+        const bool bTrusted = FMath::Abs(ReadingG - 1.f) <= AccelTrustBand;
+
+        if (!bHasUp)
+        {
+            if (!bTrusted)
+                return W;
+
+            Up = Reading * (ReadingSign / ReadingG);
+            bHasUp = true;
+        }
+        else
+        {
+            // World-fixed vector seen from a frame rotating at W: dUp/dt = Up x W
+            Up += FVector3f::CrossProduct(Up, W) * dt;
+            if (bTrusted)
+                Up += (Reading * (ReadingSign / ReadingG) - Up) * Alpha.Get(dt, TauAccel);
+            Up *= FMath::InvSqrt(FMath::Max(Up.SizeSquared(), 1e-12f));
+        }
+
+        // Up-flick axis: device Z with its vertical part removed (device Z if it points straight up)
+        FVector3f Pitch = FVector3f(0.f, 0.f, 1.f) - Up * Up.Z;
+        const float PitchLenSq = Pitch.SizeSquared();
+        if (PitchLenSq < 1e-4f)
+            return W;
+        Pitch *= FMath::InvSqrt(PitchLenSq);
+
+        const FVector3f Side = FVector3f::CrossProduct(Up, Pitch);
+        const FVector3f Play(FVector3f::DotProduct(W, Side), FVector3f::DotProduct(W, Up), FVector3f::DotProduct(W, Pitch));
+        return FMath::Lerp(W, Play, PlayFrameBlend);
+    }
+
+private:
+    FCachedEmaAlpha Alpha;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+// Fixed-capacity, wait-free single-producer/single-consumer ring buffer.
+// The producer only writes WriteIndex and the consumer only writes ReadIndex, so the two
+// sides never contend; when full, Push drops the new item and counts it.
+template <typename T, uint32 Capacity>
+class TSpscRingBuffer
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static constexpr uint32 Mask = Capacity - 1;
+
+public:
+    // Producer side
+    bool Push(const T& Item)
+    {
+        const uint32 Head = WriteIndex.load(std::memory_order_relaxed);
+        const uint32 Tail = ReadIndex.load(std::memory_order_acquire);
+        if (Head - Tail >= Capacity)
+        {
+            NumDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        Items[Head & Mask] = Item;
+        WriteIndex.store(Head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: copies up to MaxItems into Out and publishes the new read position once
+    int32 PopBatch(T* Out, int32 MaxItems)
+    {
+        const uint32 Tail = ReadIndex.load(std::memory_order_relaxed);
+        const uint32 Head = WriteIndex.load(std::memory_order_acquire);
+        const uint32 Count = FMath::Min<uint32>(Head - Tail, uint32(MaxItems));
+
+        for (uint32 i = 0; i < Count; ++i)
+        {
+            Out[i] = Items[(Tail + i) & Mask];
+        }
+
+        ReadIndex.store(Tail + Count, std::memory_order_release);
+        return int32(Count);
+    }
+
+    bool Pop(T& Out) { return PopBatch(&Out, 1) == 1; }
+
+    // Approximate when called from a third thread
+    uint32 Num() const { return WriteIndex.load(std::memory_order_acquire) - ReadIndex.load(std::memory_order_acquire); }
+    uint32 GetNumDropped() const { return NumDropped.load(std::memory_order_relaxed); }
+
+private:
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> WriteIndex{ 0 };
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> ReadIndex{ 0 };
+    std::atomic<uint32> NumDropped{ 0 };
+    alignas(PLATFORM_CACHE_LINE_SIZE) T Items[Capacity];
+};
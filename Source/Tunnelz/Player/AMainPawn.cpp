@@ -7,9 +7,14 @@
 #include "GameFramework/PlayerController.h"
 #include "Camera/PlayerCameraManager.h"
 #include "Engine/Engine.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
 
 #include "../GameMode/MainGameMode.h"
+#include "../Gesture/FlickRateCheck.h"
 #include "../Enemies/EnemyActor.h"
+#include "../Enemies/EnemySimSubsystem.h"
 
 
 namespace
@@ -33,8 +38,139 @@ namespace
     {
         return bDeg ? (GyroDeg * PI / 180.f) : GyroDeg;
     }
+
+    // Engine motion input, one sample per poll (i.e. per frame)
+    class FPlayerControllerMotionSource : public IMotionSource
+    {
+    public:
+        explicit FPlayerControllerMotionSource(UWorld* InWorld) : World(InWorld) {}
+
+        virtual const TCHAR* GetName() const override { return TEXT("Device"); }
+
+        virtual void Poll(double Now, TArray<FImuSample>& OutSamples) override
+        {
+            APlayerController* PC = World.IsValid() ? World->GetFirstPlayerController() : nullptr;
+            if (!PC) return;
+
+            FVector Tilt, RotationRate, Gravity, Accel;
+            PC->GetInputMotionState(Tilt, RotationRate, Gravity, Accel);
+
+            FImuSample& Sample = OutSamples.AddDefaulted_GetRef();
+            Sample.Timestamp = Now;
+            Sample.RotationRate = FVector3f(RotationRate);
+            Sample.Gravity = FVector3f(Gravity);
+            Sample.Accel = FVector3f(Accel);
+            Sample.Tilt = FVector3f(Tilt);
+        }
+
+    private:
+        TWeakObjectPtr<UWorld> World;
+    };
+}
+
+static TAutoConsoleVariable<FString> CVarMotionSource(
+    TEXT("Tunnelz.Motion.Source"),
+    TEXT(""),
+    TEXT("Motion input override, read when play starts. Empty/Device = platform input,\n")
+    TEXT("\"Synthetic [Axis=Up|Right|Alternate] [Peak=5] [Pulse=0.12] [Period=1.5] [Noise=0.05]\" or\n")
+    TEXT("\"Trace File=<path.tzimu> [Loop=1]\"."));
+
+static TAutoConsoleVariable<int32> CVarImuRecord(
+    TEXT("Tunnelz.Imu.Record"),
+    0,
+    TEXT("Record every IMU sample during play to Saved/ImuTraces/*.tzimu (0 = off)."));
+
+#if !UE_BUILD_SHIPPING
+// Offline tools tune like the live pawn when there is one, class defaults otherwise
+static FFlickPipeline MakeToolFlickPipeline(UWorld* World)
+{
+    const AMainPawn* Pawn = GetDefault<AMainPawn>();
+    if (World)
+    {
+        for (TActorIterator<AMainPawn> It(World); It; ++It)
+        {
+            Pawn = *It;
+            break;
+        }
+    }
+    FFlickPipeline Config;
+    Pawn->ConfigureFlickPipeline(Config);
+    return Config;
 }
 
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GImuReplayCmd(
+    TEXT("Tunnelz.Imu.Replay"),
+    TEXT("Replay a .tzimu trace through the flick pipeline. Usage: Tunnelz.Imu.Replay <Trace> [EventsCsv]"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda(
+        [](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+        {
+            if (Args.Num() < 1)
+            {
+                Ar.Log(TEXT("Usage: Tunnelz.Imu.Replay <Trace> [EventsCsv]"));
+                return;
+            }
+
+            ImuTrace::ReplayFile(Args[0], MakeToolFlickPipeline(World), Args.Num() > 1 ? Args[1] : FString(), Ar);
+        }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GGestureCaptureCmd(
+    TEXT("Tunnelz.Gesture.Capture"),
+    TEXT("Save the last motion as a gesture template and start matching it. Usage: Tunnelz.Gesture.Capture <Name> [Seconds=0.5]"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda(
+        [](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+        {
+            if (Args.Num() < 1 || !World)
+            {
+                Ar.Log(TEXT("Usage: Tunnelz.Gesture.Capture <Name> [Seconds=0.5]"));
+                return;
+            }
+            const float Requested = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 0.5f;
+            for (TActorIterator<AMainPawn> It(World); It; ++It)
+            {
+                // The recognizer only keeps its matching window of motion
+                const float MaxSeconds = It->GetMaxGestureCaptureSec();
+                const float Seconds = FMath::Min(Requested, MaxSeconds);
+                if (Seconds < Requested)
+                    Ar.Logf(TEXT("%.2fs is longer than the gesture window; capturing the last %.2fs"), Requested, MaxSeconds);
+
+                FString Path;
+                if (It->CaptureGestureTemplate(FName(*Args[0]), Seconds, Path))
+                    Ar.Logf(TEXT("Captured %s (%.2fs) to %s"), *Args[0], Seconds, *Path);
+                else
+                    Ar.Logf(TEXT("Not enough motion recorded for %.2fs"), Seconds);
+            }
+        }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GLatencyReportCmd(
+    TEXT("Tunnelz.Latency.Report"),
+    TEXT("Print the flick-to-action latency histograms collected so far in this run."),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda(
+        [](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+        {
+            if (!World) return;
+            for (TActorIterator<AMainPawn> It(World); It; ++It)
+            {
+                It->GetFlickLatency().Report(TEXT("current run"), Ar);
+            }
+        }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GFlickRateCheckCmd(
+    TEXT("Tunnelz.Flick.RateCheck"),
+    TEXT("Check that the flick pipeline makes the same decisions at every sample rate. Usage: Tunnelz.Flick.RateCheck [Hz...] (default 30 60 90 120)"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda(
+        [](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+        {
+            FlickRateCheck::FSettings Settings;
+            if (Args.Num() > 0)
+            {
+                Settings.RatesHz.Reset();
+                for (const FString& Arg : Args)
+                    Settings.RatesHz.Add(FCString::Atof(*Arg));
+            }
+            FlickRateCheck::Run(MakeToolFlickPipeline(World), Settings, Ar);
+        }));
+#endif
+
 // Sets default values
 AMainPawn::AMainPawn()
 {
@@ -56,6 +192,60 @@ AMainPawn::AMainPawn()
         ArenaSize = GM->ArenaSize;
 }
 
+void AMainPawn::ConfigureFlickPipeline(FFlickPipeline& Pipeline) const
+{
+    Pipeline.Gating.PurityMin = PurityMin;
+    Pipeline.Gating.DominanceRatio = DominanceRatio;
+    Pipeline.Gating.MinArmMagScale = MinArmMagScale;
+    Pipeline.Gating.ArmConeDeg = ArmConeDeg;
+    Pipeline.Gating.KeepConeDeg = KeepConeDeg;
+
+    Pipeline.bUseFusion = bOrientationAwareFlicks;
+    Pipeline.Fusion.PlayFrameBlend = PlayFrameBlend;
+    Pipeline.Fusion.TauAccel = GravityTimeConstant;
+
+    for (FFlickDetector* Detector : { &Pipeline.UpChan.Detector, &Pipeline.RightChan.Detector })
+    {
+        Detector->bEarlyCommit = bEarlyFlickCommit;
+        Detector->EarlyConfidence = EarlyFlickConfidence;
+    }
+}
+
+void AMainPawn::InitGestureRecognizer()
+{
+    FGestureRecognizerSettings Settings;
+    Settings.Threshold = GestureMatchThreshold;
+    Gestures.Init(Settings);
+
+    // Built-in shapes first so recorded templates with the same name replace them
+    for (const FGestureTemplate& Template : FGestureRecognizer::MakeDefaultTemplates(Settings.RateHz))
+        Gestures.AddTemplate(Template);
+
+    const FString Dir = FPaths::ProjectSavedDir() / TEXT("GestureTemplates");
+    TArray<FString> Files;
+    IFileManager::Get().FindFiles(Files, *(Dir / TEXT("*.csv")), true, false);
+    for (const FString& File : Files)
+    {
+        FGestureTemplate Template;
+        if (Template.LoadCsv(Dir / File))
+        {
+            Template.Name = FName(*FPaths::GetBaseFilename(File));
+            Gestures.AddTemplate(Template);
+        }
+    }
+}
+
+bool AMainPawn::CaptureGestureTemplate(FName Name, float Seconds, FString& OutPath)
+{
+    FGestureTemplate Template;
+    if (!Gestures.CaptureTemplate(Name, Seconds, Template))
+        return false;
+
+    OutPath = FPaths::ProjectSavedDir() / TEXT("GestureTemplates") / Name.ToString() + TEXT(".csv");
+    Gestures.AddTemplate(Template);
+    return Template.SaveCsv(OutPath);
+}
+
 void AMainPawn::BeginSession()
 {
     if (APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0))
@@ -92,13 +282,19 @@ void AMainPawn::BeginSession()
         NeutralPosition = (-FVector::ForwardVector * d);
 
         StartPos = NeutralPosition;
-        StartPos.Y -= ArenaSize.Y / 4.f;
+        CurrentLane = 0;
+        LaneSweepDir = 1;
+        StartPos.Y += GetLaneLayout().GetCenterY(CurrentLane);
 
         SetActorLocation(StartPos);
 
         LaneBlend.Reset();
         LaneStart = GetActorLocation();
         LaneTarget = StartPos;
+        SimLocation = PrevSimLocation = LaneStart;
+
+        if (UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>())
+            Sim->SetPlayerTarget(LaneTarget, GetImpactRadius());
     }
 }
 
@@ -107,11 +303,50 @@ void AMainPawn::BeginPlay()
 {
     Super::BeginPlay();
 
+    ConfigureFlickPipeline(Flick);
+    InitGestureRecognizer();
+
+    ImuSampler = MakeUnique<FImuSampler>(ImuSampleRateHz);
+    MotionInput = MotionSource::Create(CVarMotionSource.GetValueOnGameThread(), ImuSampleRateHz);
+    if (MotionInput)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Motion input injected from the %s source."), MotionInput->GetName());
+    }
+#if !WITH_EDITOR
+    else if (!ImuSampler->Start())
+    {
+        UE_LOG(LogTemp, Log, TEXT("No sensor-rate IMU path on this platform, sampling motion once per frame."));
+        MotionInput = MakeUnique<FPlayerControllerMotionSource>(GetWorld());
+    }
+#endif
+}
+
+void AMainPawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    ImuSampler.Reset(); // joins the sampling thread
+    TraceWriter.Reset();
+    MotionInput.Reset();
+
+    if (FlickLatency.GetNumCompleted() > 0)
+        FlickLatency.Report(TEXT("end of play"), *GLog);
+
+    Super::EndPlay(EndPlayReason);
+}
+
+FLaneLayout AMainPawn::GetLaneLayout() const
+{
+    if (const AMainGameMode* GM = Cast<AMainGameMode>(UGameplayStatics::GetGameMode(GetWorld())))
+        return GM->GetLaneLayout();
+
+    FLaneLayout Layout;
+    Layout.NumLanes = 2;
+    Layout.LaneWidth = ArenaSize.Y / 2.f;
+    return Layout;
 }
 
 void AMainPawn::StartLaneChange(const FVector& TargetPos, float Duration)
 {
-    LaneStart = GetActorLocation();
+    LaneStart = SimLocation;
     LaneTarget = TargetPos;
 
     if (LaneTarget != LaneStart)
@@ -120,6 +355,34 @@ void AMainPawn::StartLaneChange(const FVector& TargetPos, float Duration)
         LaneBlend.SetBlendOption(EAlphaBlendOption::ExpOut); // exponential ease-out
         LaneBlend.Reset();
     }
+
+    // Impact times are solved against the lane being moved to; the short blend is treated as instant
+    if (UEnemySimSubsystem* Sim = GetWorld()->GetSubsystem<UEnemySimSubsystem>())
+        Sim->SetPlayerTarget(LaneTarget, GetImpactRadius());
+}
+
+float AMainPawn::GetImpactRadius() const
+{
+    if (ImpactRadius > 0.f)
+        return ImpactRadius;
+
+    // The same shapes the sweep path collides with
+    const FBox Bounds = GetComponentsBoundingBox(false);
+    if (!Bounds.IsValid)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s has no colliding components; analytic enemy hits use a point. Set ImpactRadius."), *GetName());
+        return 0.f;
+    }
+    return float(Bounds.GetExtent().GetMax());
+}
+
+void AMainPawn::OnEnemyImpact_Implementation(AEnemyActor* Enemy)
+{
+    AMainGameMode* GM = Cast<AMainGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
+    if (IsInvincible() || !GM || !GM->IsPlaying())
+        return;
+
+    GM->OnPlayerDied();
 }
 
 void AMainPawn::LaneSwapAndDestroyEnemies(FVector const Pos)
@@ -131,34 +394,18 @@ void AMainPawn::LaneSwapAndDestroyEnemies(FVector const Pos)
 
     StartLaneChange(Pos, 0.11f);
 
-    // Overlap setup
-    TArray<FOverlapResult> Overlaps;
-    FCollisionShape Sphere = FCollisionShape::MakeSphere(SwapLaneDestrEnemiesRadius);
-    FCollisionQueryParams Params(SCENE_QUERY_STAT(DestroyEnemiesInRadius), false);
+    // Active enemies around the target, from the lane index (binary search per lane, no physics query)
+    TArray<AEnemyActor*> Hits;
+    if (const UEnemySimSubsystem* Sim = World->GetSubsystem<UEnemySimSubsystem>())
+        Sim->GetLaneIndex().GatherInRadius(Pos, SwapLaneDestrEnemiesRadius, false, Hits);
 
-    bool bHit = World->OverlapMultiByObjectType(
-        Overlaps,
-        Pos,
-        FQuat::Identity,
-        FCollisionObjectQueryParams(ECollisionChannel::ECC_GameTraceChannel1),
-        Sphere,
-        Params);
-
-    if (bHit)
+    AMainGameMode* GM = Cast<AMainGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
+    for (AEnemyActor* Enemy : Hits)
     {
-        for (const FOverlapResult& Result : Overlaps)
-        {
-            AActor* Actor = Result.GetActor();
-            if (Actor && Actor->IsA(AEnemyActor::StaticClass()))
-            {
-                Actor->SetActorTickEnabled(false);
-                Actor->Destroy();
-
-                AMainGameMode* GM = Cast<AMainGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
-                if (GM)
-                    GM->OnActiveEnemyDestroyed(Actor);
-            }
-        }
+        if (GM)
+            GM->ReleaseEnemy(Enemy);
+        else
+            Enemy->Destroy();
     }
 
 #if WITH_EDITOR
@@ -167,124 +414,186 @@ void AMainPawn::LaneSwapAndDestroyEnemies(FVector const Pos)
 #endif
 }
 
-// Called every frame
-void AMainPawn::Tick(float DeltaTime)
+void AMainPawn::AdvanceTimers(float DeltaTime)
 {
-    Super::Tick(DeltaTime);
-
+    PrevSimLocation = SimLocation;
     if (!LaneBlend.IsComplete())
     {
         LaneBlend.Update(DeltaTime);
         float eased = LaneBlend.GetAlpha();
 
-        FVector pos = FMath::Lerp(LaneStart, LaneTarget, eased);
-        SetActorLocation(pos, true);
+        // Swept here in both modes so a blocking hit stops the simulated pawn short, not just the drawn one
+        SetActorLocation(FMath::Lerp(LaneStart, LaneTarget, eased), true);
+        SimLocation = GetActorLocation();
+
+        if (LaneBlend.IsComplete())
+            FlickLatency.ActionComplete(0, FPlatformTime::Seconds());
     }
 
     InvincibleTimer = FMath::Max(0.f, InvincibleTimer - DeltaTime);
     HUDCooldownUpT = FMath::Max(0.f, HUDCooldownUpT - DeltaTime);
     HUDCooldownRightT = FMath::Max(0.f, HUDCooldownRightT - DeltaTime);
+}
+
+void AMainPawn::InterpolateRender(float Alpha)
+{
+    // Between two swept sim positions, so no sweep of its own; collision was settled in AdvanceTimers
+    const FVector Pos = FMath::Lerp(PrevSimLocation, SimLocation, double(FMath::Clamp(Alpha, 0.f, 1.f)));
+    if (!Pos.Equals(GetActorLocation()))
+        SetActorLocation(Pos, false, nullptr, ETeleportType::TeleportPhysics);
+}
+
+bool AMainPawn::TryChangeLane(int32 Lane)
+{
+    const FLaneLayout Lanes = GetLaneLayout();
+    Lane = Lanes.ClampLane(Lane);
+    if (!IsChangeLaneFlickReady() || !LaneBlend.IsComplete() || Lane == CurrentLane)
+        return false;
+
+    CurrentLane = Lane;
+    FVector L = LaneTarget;
+    L.Y = Lanes.GetCenterY(CurrentLane);
+    LaneSwapAndDestroyEnemies(L);
+
+    HUDCooldownUpT = Flick.UpChan.Detector.Cooldown;
+    return true;
+}
+
+bool AMainPawn::TryCollect()
+{
+    AMainGameMode* GM = Cast<AMainGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
+    if (!IsCollectFlickReady() || !GM)
+        return false;
+
+    GM->CollectFrozenEnemies();
+    HUDCooldownRightT = Flick.RightChan.Detector.Cooldown;
+    return true;
+}
+
+// Called every frame
+void AMainPawn::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (!bFixedStepDriven)
+        AdvanceTimers(DeltaTime);
 
     AMainGameMode* GM = Cast<AMainGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
     if (GM && GM->Phase != ERunPhase::Playing)
+    {
+        // Drop motion queued outside of play so it can't fire on resume
+        FImuSample Stale;
+        while (ImuSampler && ImuSampler->GetRing().Pop(Stale)) {}
+        Flick.ResetClock();
+        Gestures.Reset();
+
+        // One report per run
+        if (FlickLatency.GetNumCompleted() > 0)
+        {
+            FlickLatency.Report(TEXT("run"), *GLog);
+            FlickLatency.Reset();
+        }
         return;
+    }
 
-#if !WITH_EDITOR
-    // -------- Controller & IMU --------
-    APlayerController* PC = GetWorld()->GetFirstPlayerController();
-    if (!PC) return;
-
-    FVector Tilt, RotationRate, Gravity, Accel;
-    PC->GetInputMotionState(Tilt, RotationRate, Gravity, Accel);
-    
-    float u_raw = RotationRate.Z; // Up (toward screen top)
-    float r_raw = RotationRate.Y; // Right
-
-    static float maxu_raw = 0.f;
-    static float maxr_raw = 0.f;
-    maxu_raw = fmax(maxu_raw, u_raw);
-    maxr_raw = fmax(maxr_raw, r_raw);
-    
-    // -------- Project gyro onto axes & filter each channel --------
-    const float smUp = UpChan.Filter.Step(u_raw, DeltaTime);
-    const float smRight = RightChan.Filter.Step(r_raw, DeltaTime);
-
-    // No roll compensation needed in device space
-    const float upAdj = smUp;
-    const float rightAdj = smRight;
-
-    // Decay/gate per-channel
-    UpChan.Decay(upAdj, DeltaTime);
-    RightChan.Decay(rightAdj, DeltaTime);
-
-    // -------- Cross-talk & cone gating (UP channel) --------
-    const float u = upAdj;
-    const float r = rightAdj;
-    const float uAbs = FMath::Abs(u);
-    const float rAbs = FMath::Abs(r);
-    const float vMag = FMath::Sqrt(u * u + r * r) + 1e-6f;
-
-    const float minArmMag = UpChan.Detector.StartRateRad * MinArmMagScale;
-    const bool  rightDom = (rAbs > uAbs * DominanceRatio) && (rAbs > minArmMag);
-
-    const float angUp = FMath::Atan2(r, u); // 0=Up, +90=Right
-    const float armConeRad = FMath::DegreesToRadians(ArmConeDeg);
-    const float keepConeRad = FMath::DegreesToRadians(KeepConeDeg);
-
-    const bool bUpArmed = (UpChan.Detector.State == FFlickDetector::EState::Armed);
-    const bool inCone = (FMath::Abs(angUp) <= (bUpArmed ? keepConeRad : armConeRad));
-
-    const float purityUp = uAbs / vMag;
-    const bool  purityOk = (purityUp >= PurityMin) || (vMag < minArmMag);
-
-    const float feedUp = (inCone && purityOk && !rightDom) ? u : 0.f;
-
-    if (rightDom && UpChan.Detector.State == FFlickDetector::EState::Idle)
+    // -------- Motion sources & IMU --------
+    if (!ImuSampler)
+        return;
+
+    if (MotionInput && !ImuSampler->IsRunning())
     {
-        UpChan.Detector.PosCount = 0;
-        UpChan.Detector.NegCount = 0;
+        PolledSamples.Reset();
+        MotionInput->Poll(FPlatformTime::Seconds(), PolledSamples);
+        for (const FImuSample& Sample : PolledSamples)
+            ImuSampler->PushFromGameThread(Sample);
     }
 
-    // -------- Mirror for RIGHT channel (center cone at 90) --------
-    const float angRight = angUp - PI * 0.5f;
-    const bool  bRightArmed = (RightChan.Detector.State == FFlickDetector::EState::Armed);
-    const bool  inRightCone = (FMath::Abs(angRight) <= (bRightArmed ? keepConeRad : armConeRad));
-
-    const float purityRight = rAbs / vMag;
-    const bool  purityRightOk = (purityRight >= PurityMin) || (vMag < minArmMag);
-    const bool  upDom = (uAbs > rAbs * DominanceRatio) && (uAbs > minArmMag);
+    // Start/stop trace capture on the cvar's edge
+    const bool bRecord = CVarImuRecord.GetValueOnGameThread() != 0;
+    if (bRecord && !TraceWriter)
+    {
+        TraceWriter = MakeUnique<FImuTraceWriter>();
+        if (!TraceWriter->Open(FImuTraceWriter::MakeDefaultPath(), ImuSampler->GetRateHz()))
+        {
+            TraceWriter.Reset();
+            CVarImuRecord->Set(0, ECVF_SetByCode);
+        }
+    }
+    else if (!bRecord && TraceWriter)
+    {
+        TraceWriter.Reset();
+    }
 
-    const float feedRight = (inRightCone && purityRightOk && !upDom) ? r : 0.f;
+    // Drain everything that arrived since last frame so detection runs at sensor rate
+    DrainStartTime = FPlatformTime::Seconds();
+    FImuSample Batch[64];
+    int32 NumSamples = 0;
+    while ((NumSamples = ImuSampler->GetRing().PopBatch(Batch, UE_ARRAY_COUNT(Batch))) > 0)
+    {
+        for (int32 i = 0; i < NumSamples; ++i)
+        {
+            ProcessImuSample(Batch[i], GM);
+        }
+    }
 
-    if (upDom && RightChan.Detector.State == FFlickDetector::EState::Idle)
+    // -------- Multi-stage gestures, within the frame budget --------
+    if (bRecognizeGestures)
     {
-        RightChan.Detector.PosCount = 0;
-        RightChan.Detector.NegCount = 0;
+        GestureMatches.Reset();
+        Gestures.Evaluate(GestureBudgetMs * 1e-3, GestureMatches);
+        for (const FGestureMatch& Match : GestureMatches)
+        {
+            const int64 Value = StaticEnum<EMotionGesture>()->GetValueByNameString(Match.Name.ToString());
+            OnMotionGesture(Value != INDEX_NONE ? EMotionGesture(Value) : EMotionGesture::Custom, Match.Name, Match.Score);
+        }
     }
+}
+
+void AMainPawn::ProcessImuSample(const FImuSample& Sample, AMainGameMode* GM)
+{
+    if (TraceWriter)
+        TraceWriter->Append(Sample);
 
-    // -------- Submit detectors --------
-    const int upFlick = UpChan.Submit(feedUp, u, DeltaTime);
-    const int rightFlick = RightChan.Submit(feedRight, r, DeltaTime);
+    const FFlickPipelineResult Result = Flick.Process(Sample, 1.f / ImuSampler->GetRateHz());
+    if (bRecognizeGestures)
+        Gestures.Push(Sample.Timestamp, Flick.LastRate);
+    const int upFlick = Result.UpFlick;
+    const int rightFlick = Result.RightFlick;
 
     if (upFlick != 0 && IsChangeLaneFlickReady())
     {
+        const FFlickDetector& D = Flick.UpChan.Detector;
+        FlickLatency.Fire(0, Sample.Timestamp - D.LastOnsetToFireSec, Sample.Timestamp - D.LastArmToFireSec, Sample.Timestamp, DrainStartTime);
+        FlickLatency.ActionStart(0, FPlatformTime::Seconds());
+
+        const FLaneLayout Lanes = GetLaneLayout();
+        if (!FMath::IsWithin(CurrentLane + LaneSweepDir, 0, Lanes.NumLanes))
+            LaneSweepDir = -LaneSweepDir;
+        CurrentLane = Lanes.ClampLane(CurrentLane + LaneSweepDir);
+
         FVector L = LaneTarget;
-        const float YOffset = ArenaSize.Y / 4.f;
-        L.Y = (L.Y < 0.f) ? YOffset : -YOffset;
+        L.Y = Lanes.GetCenterY(CurrentLane);
         LaneSwapAndDestroyEnemies(L);
+        if (LaneBlend.IsComplete()) // already in that lane, nothing to blend
+            FlickLatency.ActionComplete(0, FPlatformTime::Seconds());
 
-        HUDCooldownUpT = UpChan.Detector.Cooldown; // reset cooldown
+        HUDCooldownUpT = Flick.UpChan.Detector.Cooldown; // reset cooldown
     }
 
     // Example: do something on right flick (optional)
     if (rightFlick != 0 && IsCollectFlickReady())
     {
+        const FFlickDetector& D = Flick.RightChan.Detector;
+        FlickLatency.Fire(1, Sample.Timestamp - D.LastOnsetToFireSec, Sample.Timestamp - D.LastArmToFireSec, Sample.Timestamp, DrainStartTime);
+        FlickLatency.ActionStart(1, FPlatformTime::Seconds());
+
         GEngine->AddOnScreenDebugMessage((uint64)uintptr_t(this) + 2, 0.5f, FColor::Red, TEXT("Collect Flick"));
-        GM->CollectFrozenEnemies();
+        if (GM)
+            GM->CollectFrozenEnemies();
+        FlickLatency.ActionComplete(1, FPlatformTime::Seconds());
 
-        HUDCooldownRightT = RightChan.Detector.Cooldown; // reset cooldown
+        HUDCooldownRightT = Flick.RightChan.Detector.Cooldown; // reset cooldown
     }
-#endif
 }
 
 // Input bindings
@@ -314,21 +623,23 @@ void AMainPawn::OnLook(const FInputActionValue& Value)
     GEngine->AddOnScreenDebugMessage(uint64(uintptr_t(this)), 5.f, FColor::Yellow,
         FString::Printf(TEXT("Delta: %.1f, %.1f"), Delta.X, Delta.Y));
 
-    FVector L = GetActorLocation();
-    FVector NewLocation = L;
-    float const YOffset = ArenaSize.Y / 4.f;
+    const FLaneLayout Lanes = GetLaneLayout();
+    int32 NewLane = CurrentLane;
     float const mag = 5.f;
     if (Delta.X < -mag)
     {
-        NewLocation.Y = -YOffset;
+        NewLane = Lanes.ClampLane(CurrentLane - 1);
     }
     else if (Delta.X > mag)
     {
-        NewLocation.Y = YOffset;
+        NewLane = Lanes.ClampLane(CurrentLane + 1);
     }
 
-    if (NewLocation != L)
-    {        
+    if (NewLane != CurrentLane)
+    {
+        CurrentLane = NewLane;
+        FVector NewLocation = GetActorLocation();
+        NewLocation.Y = Lanes.GetCenterY(NewLane);
         LaneSwapAndDestroyEnemies(NewLocation);
     }
 }
@@ -5,8 +5,22 @@
 #include "GameFramework/Pawn.h"
 #include "InputActionValue.h"
 #include "InputMappingContext.h"
+#include "../Gesture/FlickPipeline.h"
+#include "../Gesture/GestureLatency.h"
+#include "../Gesture/GestureRecognizer.h"
+#include "../Gesture/ImuSampler.h"
+#include "../Gesture/ImuTrace.h"
+#include "../Gesture/MotionSource.h"
+#include "../Enemies/EnemyLaneIndex.h"
 #include "AMainPawn.generated.h"
 
+class AEnemyActor;
+class AMainGameMode;
+
+// Template names the recognizer reports; recorded templates with other names arrive as Custom
+UENUM(BlueprintType)
+enum class EMotionGesture : uint8 { DoubleFlickUp, DoubleFlickRight, Twist, FlickAndHold, Custom };
+
 UCLASS()
 class TUNNELZ_API AMainPawn : public APawn
 {
@@ -19,6 +33,31 @@ public:
 
     void BeginSession();  // called by game manager
 
+    // Lane blend, i-frames and flick cooldowns; Tick runs it unless a fixed-step loop (game mode or
+    // headless sim) steps it directly
+    void AdvanceTimers(float DeltaTime);
+
+    // Set by the game mode's fixed-step loop: Tick leaves the timers to it. Each step still sweeps the
+    // actor to the new lane position (that is what collides); InterpolateRender then places it
+    // between the last two steps for drawing
+    void SetFixedStepDriven(bool bDriven) { bFixedStepDriven = bDriven; }
+    void InterpolateRender(float Alpha);
+
+    // Gameplay actions without motion input (headless bot); false while on cooldown or mid lane change
+    bool TryChangeLane(int32 Lane);
+    bool TryCollect();
+    int32 GetCurrentLane() const { return CurrentLane; }
+
+    // Copies this pawn's flick tuning into a pipeline (live input, trace replay, tuning)
+    void ConfigureFlickPipeline(FFlickPipeline& Pipeline) const;
+
+    // Flick-to-action latency collected since the current run started
+    const FGestureLatencyTracker& GetFlickLatency() const { return FlickLatency; }
+
+    // Saves the last Seconds of motion as a gesture template (Saved/GestureTemplates) and starts matching it
+    bool CaptureGestureTemplate(FName Name, float Seconds, FString& OutPath);
+    float GetMaxGestureCaptureSec() const { return Gestures.GetWindowSec(); }
+
     // Enhanced Input
     UPROPERTY(EditDefaultsOnly, Category = "Input|Enhanced")
     TObjectPtr<UInputMappingContext> IMC_Default;
@@ -32,8 +71,35 @@ public:
     UPROPERTY(EditDefaultsOnly, Category = "Behavior")
     float SwapLaneDestrEnemiesRadius = 100.f; // 1m
 
+    // Player sphere for analytic enemy collision (AMainGameMode::EnemyCollisionMode);
+    // 0 = the bounds of the pawn's colliding components
+    UPROPERTY(EditDefaultsOnly, Category = "Behavior", meta = (ClampMin = "0.0"))
+    float ImpactRadius = 0.f;
+
+    float GetImpactRadius() const;
+
+    // An active enemy reached the player (analytic collision mode). Default: the run ends unless invincible.
+    UFUNCTION(BlueprintNativeEvent, Category = "Behavior")
+    void OnEnemyImpact(AEnemyActor* Enemy);
+
+    // Gyro sampling rate when the platform has a native sensor path (Android); frame rate otherwise
+    UPROPERTY(EditDefaultsOnly, Category = "Input|IMU", meta = (ClampMin = "50.0", ClampMax = "500.0"))
+    float ImuSampleRateHz = 250.f;
+
+    // ---- Multi-stage gestures ----
+    UPROPERTY(EditDefaultsOnly, Category = "Input|Gestures")
+    bool bRecognizeGestures = true;
+
+    // Game-thread time the recognizer may spend per frame; templates not scored carry over
+    UPROPERTY(EditDefaultsOnly, Category = "Input|Gestures", meta = (ClampMin = "0.01", EditCondition = "bRecognizeGestures"))
+    float GestureBudgetMs = 0.25f;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Input|Gestures", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bRecognizeGestures"))
+    float GestureMatchThreshold = 0.82f;
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     UFUNCTION() void OnLook(const FInputActionValue& Value);
     UFUNCTION(BlueprintPure, Category = "Behavior") bool IsInvincible() const { return InvincibleTimer > 0.f; }
 
@@ -47,15 +113,23 @@ protected:
     UFUNCTION(BlueprintPure, Category = "Input")
     float GetChangeLaneFlickCooldownNorm() const
     {
-        const float maxCd = FMath::Max(UpChan.Detector.Cooldown, KINDA_SMALL_NUMBER);
+        const float maxCd = FMath::Max(Flick.UpChan.Detector.Cooldown, KINDA_SMALL_NUMBER);
         return 1.f - FMath::Clamp(HUDCooldownUpT / maxCd, 0.f, 1.f);
     }
 
     UFUNCTION(BlueprintPure, Category = "Input")
     bool IsCollectFlickReady() const { return HUDCooldownRightT <= 0.f; }
 
+    // Onset-to-fire time of the most recent lane-change flick, as measured by its detector
+    UFUNCTION(BlueprintPure, Category = "Input")
+    float GetLastChangeLaneFlickLatencyMs() const { return Flick.UpChan.Detector.LastOnsetToFireSec * 1000.f; }
+
     void LaneSwapAndDestroyEnemies(FVector const Pos);
 
+    // A multi-stage gesture matched; single flicks inside it have already fired
+    UFUNCTION(BlueprintImplementableEvent, Category = "Input")
+    void OnMotionGesture(EMotionGesture Gesture, FName TemplateName, float Score);
+
 private:
 
     FVector ArenaSize = FVector(20.f, 3.f, 4.f);
@@ -66,184 +140,27 @@ private:
     // I-frames
     float InvincibleTimer = 0.f;
 
-    // -------- Small helpers shared by filters --------
-    static float SoftDZ(float x, float dz)
-    {
-        const float ax = FMath::Abs(x);
-        return (ax <= dz) ? 0.f : FMath::Sign(x) * (ax - dz);
-    }
-    static float Median3(float a, float b, float c)
-    {
-        return a + b + c - FMath::Min3(a, b, c) - FMath::Max3(a, b, c);
-    }
+    // IMU samples drained each tick, one detector step per sample
+    void ProcessImuSample(const FImuSample& Sample, AMainGameMode* GM);
 
-    // -------- Signal filter: median3 + attack/decay EMA + soft deadzone --------
-    struct FAxisFilter
-    {
-        // Tunables
-        float TauAttack = 0.020f; // sec
-        float TauRelease = 0.080f; // sec
-        float Deadzone = 0.05f;  // rad/s (~3/s)
-
-        // State
-        float LPF = 0.f;
-        float Hist[3] = { 0.f,0.f,0.f };
-        int   HistIdx = 0;
-        bool  bFilled = false;
-
-        float Step(float raw, float dt)
-        {
-            // median(3)
-            Hist[HistIdx] = raw;
-            HistIdx = (HistIdx + 1) % 3;
-            if (HistIdx == 0) bFilled = true;
-            const float in = bFilled ? AMainPawn::Median3(Hist[0], Hist[1], Hist[2]) : raw;
-
-            // attack / release EMA
-            const float aA = 1.f - FMath::Exp(-dt / FMath::Max(1e-6f, TauAttack));
-            const float aR = 1.f - FMath::Exp(-dt / FMath::Max(1e-6f, TauRelease));
-            const float alpha = (FMath::Abs(in) > FMath::Abs(LPF)) ? aA : aR;
-            LPF = FMath::Lerp(LPF, in, alpha);
-
-            // soft deadzone
-            return AMainPawn::SoftDZ(LPF, Deadzone);
-        }
-    };
-
-    // -------- Peak-based, debounced, sign-aware flick detector --------
-    struct FFlickDetector
-    {
-        // Tunables
-        float StartRateRad = 1.1f;
-        float EndRateRad = 0.8f;
-        float MaxDuration = 0.35f; // sec
-        float Cooldown = 0.45f; // external knob; success enforces >= 0.08s
-
-        // State
-        enum class EState : uint8 { Idle, Armed } State = EState::Idle;
-        float  Timer = 0.f;
-        float  PeakAbsRate = 0.f;
-        float  PeakSign = +1.f;
-        float  CooldownT = 0.f;
-
-        // Debounce per sign (require N consecutive frames above Start)
-        static constexpr int DebounceN = 2;
-        int  PosCount = 0, NegCount = 0;
-        bool DebAbovePos = false, DebAboveNeg = false;
-        bool PrevDebAbovePos = false, PrevDebAboveNeg = false;
-
-        int Update(float rate, float dt)
-        {
-            const float dti = (dt > (1.0f / 45.0f)) ? (1.0f / 45.0f) : dt;
-            if (CooldownT > 0.f) { CooldownT = FMath::Max(0.f, CooldownT - dti); return 0; }
-
-            const float ar = FMath::Abs(rate);
-            const float sgn = (rate >= 0.f) ? +1.f : -1.f;
-
-            const bool aboveStartPos = (rate > +StartRateRad);
-            const bool aboveStartNeg = (rate < -StartRateRad);
-
-            PosCount = aboveStartPos ? FMath::Min(PosCount + 1, 1000) : 0;
-            NegCount = aboveStartNeg ? FMath::Min(NegCount + 1, 1000) : 0;
-
-            DebAbovePos = (PosCount >= DebounceN);
-            DebAboveNeg = (NegCount >= DebounceN);
-
-            const bool risingPos = (DebAbovePos && !PrevDebAbovePos);
-            const bool risingNeg = (DebAboveNeg && !PrevDebAboveNeg);
-
-            switch (State)
-            {
-            case EState::Idle:
-            {
-                if (risingPos || risingNeg)
-                {
-                    State = EState::Armed;
-                    Timer = 0.f;
-                    PeakAbsRate = ar;
-                    PeakSign = sgn;
-                }
-                break;
-            }
-            case EState::Armed:
-            {
-                Timer += dti;
-                if (ar > PeakAbsRate) PeakAbsRate = ar;
-
-                const bool aboveEnd = (ar > EndRateRad);
-                const bool sameSign = ((sgn >= 0.f) == (PeakSign >= 0.f));
-
-                const bool timeOut = (Timer > MaxDuration);
-                const bool dropBelowEnd = (!aboveEnd && Timer >= 0.02f);
-                const bool signReversalBeyondEnd = (!sameSign && aboveEnd);
-
-                if (timeOut || dropBelowEnd || signReversalBeyondEnd)
-                {
-                    int dir = 0;
-                    if (PeakAbsRate >= StartRateRad && !timeOut)
-                    {
-                        dir = (PeakSign >= 0.f) ? +1 : -1;
-                        CooldownT = FMath::Max(Cooldown, 0.08f);
-                    }
-                    else
-                    {
-                        CooldownT = 0.08f;
-                    }
-
-                    State = EState::Idle;
-                    Timer = 0.f;
-                    PeakAbsRate = 0.f;
-                    PosCount = NegCount = 0;
-
-                    PrevDebAbovePos = DebAbovePos;
-                    PrevDebAboveNeg = DebAboveNeg;
-                    return dir;
-                }
-                break;
-            }
-            }
-
-            PrevDebAbovePos = DebAbovePos;
-            PrevDebAboveNeg = DebAboveNeg;
-            return 0;
-        }
-    };
-
-    // -------- One per-axis channel: filter + detector + small rest/cooldown gate --------
-    struct FAxisChannel
-    {
-        FAxisFilter    Filter;
-        FFlickDetector Detector;
-
-        // Pawn-level rest + manual cooldown (prevents rebound doubles)
-        bool  bNeedsRest = false;
-        float ManualCDT = 0.f;
-        float RestRate = 0.25f; // must dip below this once after a hit
-
-        void Decay(float smoothedRate, float dt)
-        {
-            if (ManualCDT > 0.f) ManualCDT = FMath::Max(0.f, ManualCDT - dt);
-            if (bNeedsRest && FMath::Abs(smoothedRate) < RestRate)
-                bNeedsRest = false;
-        }
-        int Submit(float feedRate, float smoothedForRest, float dt)
-        {
-            const int dir = Detector.Update(feedRate, dt);
-            if (dir == 0) return 0;
-
-            if (ManualCDT <= 0.f && !bNeedsRest)
-            {
-                ManualCDT = 0.18f;
-                bNeedsRest = true;
-                return dir;
-            }
-            return 0;
-        }
-    };
-
-    // Channels
-    FAxisChannel UpChan;
-    FAxisChannel RightChan;
+    TUniquePtr<FImuSampler> ImuSampler;
+    TUniquePtr<FImuTraceWriter> TraceWriter; // while Tunnelz.Imu.Record is set
+
+    // Game-thread motion producer when the sampler thread isn't running (device, synthetic or trace)
+    TUniquePtr<IMotionSource> MotionInput;
+    TArray<FImuSample> PolledSamples;
+
+    // Probes from flick onset to the end of its lane change; reported per run
+    FGestureLatencyTracker FlickLatency;
+    double DrainStartTime = 0.0;
+
+    // Template matching over the play-frame rates, evaluated once per frame
+    void InitGestureRecognizer();
+    FGestureRecognizer Gestures;
+    TArray<FGestureMatch> GestureMatches;
+
+    // Channels (UpChan / RightChan) and their gating
+    FFlickPipeline Flick;
 
     // Cooldowns for UI
     float HUDCooldownUpT = 0.f;
@@ -268,10 +185,41 @@ protected:
     UPROPERTY(EditAnywhere, Category = "Flick|Tuning", meta = (ClampMin = "0.0", ClampMax = "90.0"))
     float KeepConeDeg = 28.f;
 
+    // ---- Early commit ----
+    // Fire on the rising edge of a flick once its predicted peak is confident, instead of at its end
+    UPROPERTY(EditAnywhere, Category = "Flick|Tuning")
+    bool bEarlyFlickCommit = false;
+
+    UPROPERTY(EditAnywhere, Category = "Flick|Tuning", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bEarlyFlickCommit"))
+    float EarlyFlickConfidence = 0.6f;
+
+    // ---- Orientation ----
+    // Judge flicks in a gravity-aligned play frame so a tilted grip doesn't cause cross-talk
+    UPROPERTY(EditAnywhere, Category = "Flick|Tuning")
+    bool bOrientationAwareFlicks = true;
+
+    // 0 = raw device axes, 1 = fully gravity-aligned
+    UPROPERTY(EditAnywhere, Category = "Flick|Tuning", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bOrientationAwareFlicks"))
+    float PlayFrameBlend = 1.f;
+
+    // How quickly gravity readings correct the gyro-propagated orientation (sec)
+    UPROPERTY(EditAnywhere, Category = "Flick|Tuning", meta = (ClampMin = "0.05", ClampMax = "5.0", EditCondition = "bOrientationAwareFlicks"))
+    float GravityTimeConstant = 0.5f;
+
 private:
     // Lane switching
     void StartLaneChange(const FVector& TargetPos, float Duration);
 
     FAlphaBlend LaneBlend;
     FVector LaneStart, LaneTarget;
+
+    // Lane position after the last step and the one before it
+    FVector SimLocation = FVector::ZeroVector;
+    FVector PrevSimLocation = FVector::ZeroVector;
+    bool bFixedStepDriven = false;
+
+    // Lanes come from the game mode (NumLanes / LaneWidth); flicks sweep back and forth across them
+    FLaneLayout GetLaneLayout() const;
+    int32 CurrentLane = 0;
+    int32 LaneSweepDir = 1;
 };
@@ -12,4 +12,9 @@ class TUNNELZ_API UHighScoreSaveGame : public USaveGame
 public:
 	UPROPERTY(SaveGame)
 	unsigned int HighScore = 0;
+
+	// Runs appended to the run history file (FRunHistoryFile), which holds the runs themselves so this
+	// object stays small to save
+	UPROPERTY(SaveGame)
+	int32 NumRuns = 0;
 };
@@ -0,0 +1,176 @@
+#include "RunHistory.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Kismet/GameplayStatics.h"
+
+#include "../GameMode/MainGameMode.h"
+
+namespace
+{
+	void WriteHeader(FArchive& Ar)
+	{
+		uint32 Magic = FRunHistoryFile::Magic;
+		uint16 Version = FRunHistoryFile::Version;
+		uint16 RecordSize = FRunHistoryFile::RecordSize;
+		Ar << Magic << Version << RecordSize;
+	}
+
+	// Whether Path can be appended to as is: this version's header and whole records only
+	bool IsAppendable(const FString& Path)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		const int64 Size = FileManager.FileSize(*Path);
+		if (Size < FRunHistoryFile::HeaderSize || (Size - FRunHistoryFile::HeaderSize) % FRunHistoryFile::RecordSize != 0)
+			return false;
+
+		TUniquePtr<FArchive> Ar(FileManager.CreateFileReader(*Path, FILEREAD_Silent));
+		if (!Ar)
+			return false;
+		uint32 Magic = 0;
+		uint16 Version = 0;
+		uint16 RecordSize = 0;
+		*Ar << Magic << Version << RecordSize;
+		return Magic == FRunHistoryFile::Magic && Version == FRunHistoryFile::Version && RecordSize == FRunHistoryFile::RecordSize;
+	}
+
+	// Rewrites the whole file in the current format. Written next to it and moved over it, so a crash
+	// part way leaves the old file intact.
+	bool Rewrite(const FString& Path, TArray<FRunRecord>& Records)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Ar(Bytes);
+		WriteHeader(Ar);
+		for (FRunRecord& R : Records)
+			Ar << R;
+
+		const FString TempPath = Path + TEXT(".tmp");
+		return FFileHelper::SaveArrayToFile(Bytes, *TempPath) && IFileManager::Get().Move(*Path, *TempPath, true);
+	}
+}
+
+FRunHistoryFile::FRunHistoryFile()
+	: Path(FPaths::ProjectSavedDir() / TEXT("SaveGames") / TEXT("RunHistory.bin"))
+	, Pipe(TEXT("RunHistory"))
+{
+}
+
+FRunHistoryFile::~FRunHistoryFile()
+{
+	Pipe.WaitUntilEmpty();
+}
+
+void FRunHistoryFile::Append(const FRunRecord& Record)
+{
+	Pipe.Launch(TEXT("RunHistoryAppend"), [Path = Path, Record]() mutable
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		if (!IsAppendable(Path))
+		{
+			// Missing, another version, or a torn last record: carry over what's readable in this format.
+			// A file that isn't a run history at all is moved aside rather than overwritten.
+			TArray<FRunRecord> Records;
+			if (!Load(Path, Records) && FileManager.FileExists(*Path))
+			{
+				const FString AsidePath = Path + TEXT(".unreadable");
+				UE_LOG(LogTemp, Warning, TEXT("Run history: %s is not a run history; moved to %s"), *Path, *AsidePath);
+				FileManager.Move(*AsidePath, *Path, true);
+			}
+			Records.Add(Record);
+			if (!Rewrite(Path, Records))
+				UE_LOG(LogTemp, Warning, TEXT("Run history: could not write %s"), *Path);
+			return;
+		}
+
+		TUniquePtr<FArchive> Ar(FileManager.CreateFileWriter(*Path, FILEWRITE_Append));
+		if (!Ar)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Run history: could not open %s"), *Path);
+			return;
+		}
+		*Ar << Record;
+		Ar->Close();
+	});
+}
+
+void FRunHistoryFile::LoadAsync(TFunction<void(TArray<FRunRecord>&&)> OnLoaded)
+{
+	Pipe.Launch(TEXT("RunHistoryLoad"), [Path = Path, OnLoaded = MoveTemp(OnLoaded)]() mutable
+	{
+		TArray<FRunRecord> Records;
+		Load(Path, Records);
+		AsyncTask(ENamedThreads::GameThread, [OnLoaded = MoveTemp(OnLoaded), Records = MoveTemp(Records)]() mutable
+		{
+			OnLoaded(MoveTemp(Records));
+		});
+	});
+}
+
+bool FRunHistoryFile::Load(const FString& Path, TArray<FRunRecord>& Out)
+{
+	Out.Reset();
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent) || Bytes.Num() < HeaderSize)
+		return false;
+
+	FMemoryReader Ar(Bytes);
+	uint32 FileMagic = 0;
+	uint16 FileVersion = 0;
+	uint16 FileRecordSize = 0;
+	Ar << FileMagic << FileVersion << FileRecordSize;
+	if (FileMagic != Magic || FileRecordSize < RecordSize)
+		return false;
+
+	// Later versions may grow records; the fields known here come first
+	const int32 Num = (Bytes.Num() - HeaderSize) / FileRecordSize;
+	Out.SetNum(Num);
+	for (int32 i = 0; i < Num; ++i)
+	{
+		Ar.Seek(HeaderSize + int64(i) * FileRecordSize);
+		Ar << Out[i];
+	}
+	return true;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GRunHistoryCmd(
+	TEXT("Tunnelz.Runs.History"),
+	TEXT("Tunnelz.Runs.History [Count]: loads the run history in the background and logs a summary and the last Count runs (default 10)."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		AMainGameMode* GM = World ? Cast<AMainGameMode>(UGameplayStatics::GetGameMode(World)) : nullptr;
+		if (!GM)
+		{
+			Ar.Log(TEXT("No game mode (not in a game world?)"));
+			return;
+		}
+
+		const int32 Count = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 0) : 10;
+		const double Start = FPlatformTime::Seconds();
+		const FString Path = GM->GetRunHistory().GetPath();
+		GM->GetRunHistory().LoadAsync([Count, Start, Path](TArray<FRunRecord>&& Records)
+		{
+			uint32 Best = 0;
+			double SumScore = 0.0, SumTime = 0.0;
+			for (const FRunRecord& R : Records)
+			{
+				Best = FMath::Max(Best, R.Score);
+				SumScore += R.Score;
+				SumTime += R.DurationSec;
+			}
+			const int32 N = FMath::Max(Records.Num(), 1);
+			UE_LOG(LogTemp, Display, TEXT("Run history %s: %d runs (loaded in %.1f ms), best %u, mean score %.1f, mean %.1f s, %.1f h played"),
+				*Path, Records.Num(), (FPlatformTime::Seconds() - Start) * 1e3, Best, SumScore / N, SumTime / N, SumTime / 3600.0);
+			for (int32 i = FMath::Max(Records.Num() - Count, 0); i < Records.Num(); ++i)
+			{
+				const FRunRecord& R = Records[i];
+				UE_LOG(LogTemp, Display, TEXT("  #%-6d score %6u  %7.1f s  level %2u  seed %d"), i + 1, R.Score, R.DurationSec, R.Level, R.Seed);
+			}
+		});
+		Ar.Logf(TEXT("Loading %s..."), *Path);
+	}));
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Pipe.h"
+
+// One finished run, 16 bytes on disk
+struct FRunRecord
+{
+	uint32 Score = 0;
+	float DurationSec = 0.f;
+	int32 Seed = 0;
+	uint16 Level = 0;
+	uint16 Flags = 0; // reserved
+
+	friend FArchive& operator<<(FArchive& Ar, FRunRecord& R)
+	{
+		return Ar << R.Score << R.DurationSec << R.Seed << R.Level << R.Flags;
+	}
+};
+
+// Append-only run history next to the save games (RunHistory.bin): a 8-byte header followed by
+// fixed-size records, so adding a run writes 16 bytes and loading thousands of runs is one file read.
+// Appends only go to a file with this version's header; anything else (missing, older, a torn last
+// record) is rewritten through a temp file first. All file work runs in order on a background pipe;
+// loads queue behind pending appends and see them.
+class FRunHistoryFile
+{
+public:
+	FRunHistoryFile();
+	~FRunHistoryFile(); // waits for pending writes
+
+	void Append(const FRunRecord& Record);
+
+	// OnLoaded runs on the game thread with every record, oldest first
+	void LoadAsync(TFunction<void(TArray<FRunRecord>&&)> OnLoaded);
+
+	// Blocking read; false if the file is missing or not a run history
+	static bool Load(const FString& Path, TArray<FRunRecord>& Out);
+
+	const FString& GetPath() const { return Path; }
+
+	static constexpr uint32 Magic = 0x48525A54; // "TZRH"
+	static constexpr uint16 Version = 1;
+	static constexpr int32 HeaderSize = 8;
+	static constexpr int32 RecordSize = 16;
+
+private:
+	FString Path;
+	UE::Tasks::FPipe Pipe;
+};
@@ -17,9 +17,15 @@ public class Tunnelz : ModuleRules
 			"UMG"
         });
 
-		PrivateDependencyModuleNames.AddRange(new string[] {  });
+		PrivateDependencyModuleNames.AddRange(new string[] { "RenderCore" });
 
 		PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
+
+		// NDK sensor API for the sensor-rate IMU sampler
+		if (Target.Platform == UnrealTargetPlatform.Android)
+		{
+			PublicSystemLibraries.Add("android");
+		}
 		
 		// Uncomment if you are using online features
 		// PrivateDependencyModuleNames.Add("OnlineSubsystem");